@@ -262,6 +262,188 @@ Image* resizeOpenMP(const Image *source, int lebarBaru, int tinggiBaru, int numT
 }
 #endif
 
+/* ============================================================================
+ * RESIZE PLAN (Koordinat & Bobot Dihitung Sekali)
+ * ============================================================================
+ *
+ * IDE:
+ * x0, x1, fx hanya bergantung pada kolom tujuan, sedangkan y0, y1, fy
+ * hanya bergantung pada baris tujuan. Jadi cukup dihitung sekali per
+ * geometri (lebar/tinggi sumber & tujuan) lalu disimpan dalam tabel.
+ * Loop per pixel tinggal ambil nilai tabel + weighted sum.
+ *
+ * BORDER:
+ * Koordinat yang jatuh di (ukuran - 1) atau lebih dipetakan ke pixel
+ * terakhir dengan fraksi 0 (pengganti clamp "- 1.001f").
+ *
+ * ============================================================================ */
+
+/* Struktur plan: tabel per kolom dan per baris tujuan */
+typedef struct {
+    int lebarSumber, tinggiSumber;
+    int lebarTujuan, tinggiTujuan;
+    int   *x0;      /* [lebarTujuan]  kolom kiri */
+    int   *x1;      /* [lebarTujuan]  kolom kanan */
+    float *fx;      /* [lebarTujuan]  fraksi horizontal */
+    int   *y0;      /* [tinggiTujuan] baris atas */
+    int   *y1;      /* [tinggiTujuan] baris bawah */
+    float *fy;      /* [tinggiTujuan] fraksi vertikal */
+} ResizePlan;
+
+/**
+ * Isi tabel indeks & fraksi untuk satu sumbu
+ */
+static void isiTabelSumbu(int ukuranSumber, int ukuranTujuan,
+                          int *idx0, int *idx1, float *fraksi) {
+    float skala = (float)ukuranSumber / ukuranTujuan;
+    int i;
+
+    for (i = 0; i < ukuranTujuan; i++) {
+        float src = i * skala;
+
+        if (src >= (float)(ukuranSumber - 1)) {
+            /* Border: pakai pixel terakhir, fraksi 0 */
+            idx0[i] = ukuranSumber - 1;
+            idx1[i] = ukuranSumber - 1;
+            fraksi[i] = 0.0f;
+        } else {
+            idx0[i] = (int)src;
+            idx1[i] = idx0[i] + 1;
+            fraksi[i] = src - (float)idx0[i];
+        }
+    }
+}
+
+/**
+ * Menghapus plan dan free memory
+ */
+void hapusResizePlan(ResizePlan *plan) {
+    if (plan) {
+        free(plan->x0);
+        free(plan->x1);
+        free(plan->fx);
+        free(plan->y0);
+        free(plan->y1);
+        free(plan->fy);
+        free(plan);
+    }
+}
+
+/**
+ * Membuat plan untuk geometri resize tertentu
+ * @return Pointer ke ResizePlan, atau NULL jika gagal / ukuran tidak valid
+ */
+ResizePlan* buatResizePlan(int lebarSumber, int tinggiSumber,
+                           int lebarTujuan, int tinggiTujuan) {
+    ResizePlan *plan;
+
+    if (lebarSumber <= 0 || tinggiSumber <= 0 || lebarTujuan <= 0 || tinggiTujuan <= 0)
+        return NULL;
+
+    plan = (ResizePlan*)malloc(sizeof(ResizePlan));
+    if (!plan) return NULL;
+
+    plan->lebarSumber = lebarSumber;
+    plan->tinggiSumber = tinggiSumber;
+    plan->lebarTujuan = lebarTujuan;
+    plan->tinggiTujuan = tinggiTujuan;
+
+    plan->x0 = (int*)malloc(lebarTujuan * sizeof(int));
+    plan->x1 = (int*)malloc(lebarTujuan * sizeof(int));
+    plan->fx = (float*)malloc(lebarTujuan * sizeof(float));
+    plan->y0 = (int*)malloc(tinggiTujuan * sizeof(int));
+    plan->y1 = (int*)malloc(tinggiTujuan * sizeof(int));
+    plan->fy = (float*)malloc(tinggiTujuan * sizeof(float));
+
+    if (!plan->x0 || !plan->x1 || !plan->fx || !plan->y0 || !plan->y1 || !plan->fy) {
+        hapusResizePlan(plan);
+        return NULL;
+    }
+
+    isiTabelSumbu(lebarSumber, lebarTujuan, plan->x0, plan->x1, plan->fx);
+    isiTabelSumbu(tinggiSumber, tinggiTujuan, plan->y0, plan->y1, plan->fy);
+
+    return plan;
+}
+
+/**
+ * Hitung satu baris tujuan memakai plan
+ * Interpolasi horizontal pada 2 baris sumber, lalu interpolasi vertikal
+ */
+static void resizeBarisPlan(const Image *source, const ResizePlan *plan,
+                            Pixel *barisTujuan, int y) {
+    const Pixel *atas = source->data + plan->y0[y] * source->width;
+    const Pixel *bawah = source->data + plan->y1[y] * source->width;
+    float fy = plan->fy[y];
+    int x;
+
+    for (x = 0; x < plan->lebarTujuan; x++) {
+        const Pixel *f00 = &atas[plan->x0[x]];
+        const Pixel *f10 = &atas[plan->x1[x]];
+        const Pixel *f01 = &bawah[plan->x0[x]];
+        const Pixel *f11 = &bawah[plan->x1[x]];
+        float fx = plan->fx[x];
+        Pixel a, b;
+
+        /* Horizontal */
+        a.r = f00->r + fx * (f10->r - f00->r);
+        a.g = f00->g + fx * (f10->g - f00->g);
+        a.b = f00->b + fx * (f10->b - f00->b);
+        b.r = f01->r + fx * (f11->r - f01->r);
+        b.g = f01->g + fx * (f11->g - f01->g);
+        b.b = f01->b + fx * (f11->b - f01->b);
+
+        /* Vertikal */
+        barisTujuan[x].r = a.r + fy * (b.r - a.r);
+        barisTujuan[x].g = a.g + fy * (b.g - a.g);
+        barisTujuan[x].b = a.b + fy * (b.b - a.b);
+    }
+}
+
+/**
+ * Resize serial memakai plan yang sudah dibuat
+ * @return Image baru, atau NULL jika ukuran source tidak cocok dengan plan
+ */
+Image* resizeSerialPlan(const Image *source, const ResizePlan *plan) {
+    Image *dest;
+    int y;
+
+    if (!plan || source->width != plan->lebarSumber || source->height != plan->tinggiSumber)
+        return NULL;
+
+    dest = buatImage(plan->lebarTujuan, plan->tinggiTujuan);
+    if (!dest) return NULL;
+
+    for (y = 0; y < plan->tinggiTujuan; y++) {
+        resizeBarisPlan(source, plan, dest->data + y * dest->width, y);
+    }
+
+    return dest;
+}
+
+#ifdef USE_OPENMP
+/**
+ * Resize OpenMP memakai plan: paralel per baris tujuan
+ */
+Image* resizeOpenMPPlan(const Image *source, const ResizePlan *plan, int numThreads) {
+    Image *dest;
+    int y;
+
+    if (!plan || source->width != plan->lebarSumber || source->height != plan->tinggiSumber)
+        return NULL;
+
+    dest = buatImage(plan->lebarTujuan, plan->tinggiTujuan);
+    if (!dest) return NULL;
+
+    #pragma omp parallel for num_threads(numThreads) schedule(static)
+    for (y = 0; y < plan->tinggiTujuan; y++) {
+        resizeBarisPlan(source, plan, dest->data + y * dest->width, y);
+    }
+
+    return dest;
+}
+#endif
+
 /* ============================================================================
  * FUNGSI UNTUK MEMBUAT TEST IMAGE
  * ============================================================================ */
@@ -309,6 +491,7 @@ void jalankanBenchmark() {
         int ukuran = ukuranTest[t];
         Image *testImg;
         Image *hasilSerial;
+        ResizePlan *plan;
         clock_t mulai, selesai;
         double waktuSerial;
 
@@ -332,6 +515,24 @@ void jalankanBenchmark() {
 
         if (hasilSerial) hapusImage(hasilSerial);
 
+        /* ====== BENCHMARK SERIAL + PLAN ====== */
+        /* Plan dibuat sekali di luar timing (dipakai ulang seperti di produksi) */
+        plan = buatResizePlan(ukuran, ukuran, ukuranTarget, ukuranTarget);
+        if (plan) {
+            Image *hasilPlan;
+            double waktuPlan;
+
+            mulai = clock();
+            hasilPlan = resizeSerialPlan(testImg, plan);
+            selesai = clock();
+            waktuPlan = ((double)(selesai - mulai)) / CLOCKS_PER_SEC * 1000.0;
+
+            printf("  [SERIAL-PLAN]  Waktu: %7.0f ms  |  Speedup: %.2fx\n",
+                   waktuPlan, waktuSerial / waktuPlan);
+
+            if (hasilPlan) hapusImage(hasilPlan);
+        }
+
         /* ====== BENCHMARK OPENMP ====== */
 #ifdef USE_OPENMP
         {
@@ -353,6 +554,19 @@ void jalankanBenchmark() {
                        threads, waktuOmp, speedup);
 
                 if (hasilOmp) hapusImage(hasilOmp);
+
+                if (plan) {
+                    mulai = clock();
+                    hasilOmp = resizeOpenMPPlan(testImg, plan, threads);
+                    selesai = clock();
+                    waktuOmp = ((double)(selesai - mulai)) / CLOCKS_PER_SEC * 1000.0;
+
+                    speedup = waktuSerial / waktuOmp;
+                    printf("  [OpenMP-%d-PLAN] Waktu: %7.0f ms  |  Speedup: %.2fx\n",
+                           threads, waktuOmp, speedup);
+
+                    if (hasilOmp) hapusImage(hasilOmp);
+                }
             }
         }
 #else
@@ -360,6 +574,7 @@ void jalankanBenchmark() {
 #endif
 
         printf("\n");
+        hapusResizePlan(plan);
         hapusImage(testImg);
     }
 
@@ -9,10 +9,23 @@
  * Compile:
  *   Serial:  gcc -o bilinear_serial bilinear_openmp.c -std=c99 -O3
  *   OpenMP:  gcc -o bilinear_omp bilinear_openmp.c -std=c99 -O3 -fopenmp -DUSE_OPENMP
+ *   Profil:  tambah -DRESIZE_INSTRUMENT, lalu --bench --profile FILE
+ *
+ * Run:
+ *   ./bilinear_omp                 Konsep + benchmark ringkas
+ *   ./bilinear_omp --bench [...]   Benchmark harness (lihat --help)
+ *   ./bilinear_omp --scaling [...] Sweep thread/ukuran/rasio vs peak STREAM
+ *   ./bilinear_omp --selftest      Cek fast path == path umum (exit 1 jika beda)
+ *   ./bilinear_omp --resize IN OUT WxH [--threads N]
+ *                                  Resize file PPM/PGM/raw (mmap)
  */
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 
@@ -20,6 +33,22 @@
 #include <omp.h>
 #endif
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define HAVE_MMAP_IO 1
+#define HAVE_PTHREADS 1
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#define HAVE_NUMA_SYSCALLS 1
+#endif
+
 /* ============================================================================
  * STRUKTUR DATA
  * ============================================================================ */
@@ -32,19 +61,324 @@ typedef struct {
     Pixel *data;
     int width;
     int height;
+    int stride;         /* pixel per baris (>= width) */
 } Image;
 
+/* Image 8-bit interleaved: 1 (gray), 3 (RGB) atau 4 (RGBA) channel */
+typedef struct {
+    uint8_t *data;
+    int width;
+    int height;
+    int channels;
+    int stride;         /* byte per baris */
+} ImageU8;
+
+/* ============================================================================
+ * ALOKATOR BUFFER IMAGE (aligned, huge page, pool per size class)
+ * ============================================================================
+ * Setiap buffer image dimulai di batas 64 byte dan createImage/createImageU8
+ * memadding stride supaya setiap baris juga 64-byte aligned (load vektor
+ * tidak pernah memotong cache line di awal baris).
+ *
+ * Buffer >= 2 MB di-mmap langsung dengan panjang kelipatan 2 MB:
+ *  - HUGEPAGE_TRANSPARENT (default): madvise(MADV_HUGEPAGE), kernel memakai
+ *    THP jika tersedia
+ *  - HUGEPAGE_EXPLICIT: MAP_HUGETLB dari pool hugetlbfs, fallback ke THP
+ *    jika pool kosong
+ * Buffer yang di-free masuk free list per size class (langkah ~1.25x) dan
+ * dipakai ulang oleh alokasi berikutnya di class yang sama, jadi loop
+ * benchmark/server tidak membayar mmap/munmap + page fault setiap panggilan.
+ * Total buffer idle dibatasi (default 256 MB); sisanya dikembalikan ke OS.
+ */
+
+#define IMAGE_ALIGN              64
+#define IMAGE_HEADER             IMAGE_ALIGN     /* ImageBlock sebelum data */
+#define IMAGE_MIN_CLASS          4096
+#define IMAGE_NUM_CLASSES        128
+#define HUGE_PAGE_SIZE           ((size_t)2 << 20)
+#define DEFAULT_IMAGE_POOL_LIMIT ((size_t)256 << 20)
+
+typedef enum { HUGEPAGE_OFF, HUGEPAGE_TRANSPARENT, HUGEPAGE_EXPLICIT } HugePageMode;
+
+typedef struct {
+    unsigned long long allocs;      /* semua imageBufferAlloc */
+    unsigned long long reuses;      /* dilayani dari pool */
+    unsigned long long hugeAllocs;  /* buffer baru dengan huge page */
+    size_t cachedBytes;     /* buffer idle di pool */
+    size_t limitBytes;
+} ImagePoolStats;
+
+typedef struct ImageBlock {
+    struct ImageBlock *next;    /* free list */
+    void *base;                 /* awal malloc / mmap */
+    size_t bytes;               /* kapasitas data (ukuran class - header) */
+    size_t mapBytes;            /* > 0: blok mmap, panjang untuk munmap */
+    int sizeClass;              /* -1 = di luar class, tidak di-pool */
+} ImageBlock;
+
+typedef char imageBlockFitsHeader[(sizeof(ImageBlock) <= IMAGE_HEADER) ? 1 : -1];
+
+static ImageBlock *imagePool[IMAGE_NUM_CLASSES];
+static HugePageMode imageHugePages = HUGEPAGE_TRANSPARENT;
+static ImagePoolStats imagePoolCounters = { 0, 0, 0, 0, DEFAULT_IMAGE_POOL_LIMIT };
+
+#ifdef HAVE_PTHREADS
+static pthread_mutex_t imagePoolLock = PTHREAD_MUTEX_INITIALIZER;
+#define IMAGE_POOL_LOCK()   pthread_mutex_lock(&imagePoolLock)
+#define IMAGE_POOL_UNLOCK() pthread_mutex_unlock(&imagePoolLock)
+#else
+#define IMAGE_POOL_LOCK()   ((void)0)
+#define IMAGE_POOL_UNLOCK() ((void)0)
+#endif
+
+static size_t roundUpSize(size_t value, size_t unit) {
+    return (value + unit - 1) / unit * unit;
+}
+
+/* Stride (elemen) agar stride * elemBytes kelipatan IMAGE_ALIGN */
+static int alignedStride(int width, int elemBytes) {
+    int unit = IMAGE_ALIGN, a = IMAGE_ALIGN, b = elemBytes;
+
+    while (b) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    unit /= a;
+    return (int)roundUpSize((size_t)width, (size_t)unit);
+}
+
+/* Ukuran class (header + data) untuk total byte; langkah 1.25x dibulatkan ke
+ * page, dan ke kelipatan 2 MB mulai HUGE_PAGE_SIZE (panjang mmap valid untuk
+ * MAP_HUGETLB). *sizeClass = -1 jika melebihi class terbesar. */
+static size_t imageClassBytes(size_t total, int *sizeClass) {
+    size_t size = IMAGE_MIN_CLASS;
+    int c = 0;
+
+    while (size < total && c < IMAGE_NUM_CLASSES - 1) {
+        size = roundUpSize(size + size / 4, size >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : 4096);
+        c++;
+    }
+    if (size < total) {
+        *sizeClass = -1;
+        return roundUpSize(total, HUGE_PAGE_SIZE);
+    }
+    *sizeClass = c;
+    return size;
+}
+
+/* Blok baru dari OS; NULL jika gagal */
+static ImageBlock* imageBlockCreate(size_t classBytes, int sizeClass, HugePageMode hugePages) {
+    ImageBlock *block;
+    char *base;
+    size_t mapBytes = 0;
+    int huge = 0;
+
+#ifdef HAVE_MMAP_IO
+    if (classBytes >= HUGE_PAGE_SIZE) {
+        void *map = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+        if (hugePages == HUGEPAGE_EXPLICIT) {
+            map = mmap(NULL, classBytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            huge = map != MAP_FAILED;
+        }
+#endif
+        if (map == MAP_FAILED) {
+            map = mmap(NULL, classBytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (map == MAP_FAILED) return NULL;
+#ifdef MADV_HUGEPAGE
+            if (hugePages != HUGEPAGE_OFF)
+                huge = madvise(map, classBytes, MADV_HUGEPAGE) == 0;
+#endif
+        }
+        base = (char*)map;
+        mapBytes = classBytes;
+    } else
+#endif
+    {
+        /* malloc hanya menjamin alignment 16: lebihkan IMAGE_ALIGN lalu geser */
+        base = (char*)malloc(classBytes + IMAGE_ALIGN);
+        if (!base) return NULL;
+    }
+
+    block = (ImageBlock*)(base + (IMAGE_ALIGN - (uintptr_t)base % IMAGE_ALIGN) % IMAGE_ALIGN);
+    block->next = NULL;
+    block->base = base;
+    block->bytes = classBytes - IMAGE_HEADER;
+    block->mapBytes = mapBytes;
+    block->sizeClass = sizeClass;
+
+    if (huge) {
+        IMAGE_POOL_LOCK();
+        imagePoolCounters.hugeAllocs++;
+        IMAGE_POOL_UNLOCK();
+    }
+    return block;
+}
+
+static void imageBlockDestroy(ImageBlock *block) {
+#ifdef HAVE_MMAP_IO
+    if (block->mapBytes) {
+        munmap(block->base, block->mapBytes);
+        return;
+    }
+#endif
+    free(block->base);
+}
+
+/* Buffer data image: 64-byte aligned, minimal bytes, dari pool jika ada.
+ * zero = 1 menjamin isi nol (blok mmap baru sudah nol dari kernel).
+ * pooled = 0 selalu minta blok baru: halaman mmap (>= 2 MB) belum disentuh
+ * sehingga first-touch menentukan node NUMA-nya; blok dari pool sudah
+ * tinggal di node pemakai sebelumnya. Dilepas dengan imageBufferFree. */
+static void* imageBufferGet(size_t bytes, int zero, int pooled) {
+    ImageBlock *block = NULL;
+    HugePageMode hugePages;
+    int sizeClass, fresh = 0;
+    size_t classBytes = imageClassBytes(bytes + IMAGE_HEADER, &sizeClass);
+
+    IMAGE_POOL_LOCK();
+    hugePages = imageHugePages;
+    imagePoolCounters.allocs++;
+    if (pooled && sizeClass >= 0 && imagePool[sizeClass]) {
+        block = imagePool[sizeClass];
+        imagePool[sizeClass] = block->next;
+        imagePoolCounters.cachedBytes -= block->bytes + IMAGE_HEADER;
+        imagePoolCounters.reuses++;
+    }
+    IMAGE_POOL_UNLOCK();
+
+    if (!block) {
+        block = imageBlockCreate(classBytes, sizeClass, hugePages);
+        if (!block) return NULL;
+        fresh = 1;
+    }
+
+    if (zero && !(fresh && block->mapBytes))
+        memset((char*)block + IMAGE_HEADER, 0, bytes);
+    return (char*)block + IMAGE_HEADER;
+}
+
+static void* imageBufferAlloc(size_t bytes, int zero) {
+    return imageBufferGet(bytes, zero, 1);
+}
+
+static void imageBufferFree(void *data) {
+    ImageBlock *block;
+    int keep = 0;
+
+    if (!data) return;
+    block = (ImageBlock*)((char*)data - IMAGE_HEADER);
+
+    IMAGE_POOL_LOCK();
+    if (block->sizeClass >= 0 &&
+        imagePoolCounters.cachedBytes + block->bytes + IMAGE_HEADER <= imagePoolCounters.limitBytes) {
+        block->next = imagePool[block->sizeClass];
+        imagePool[block->sizeClass] = block;
+        imagePoolCounters.cachedBytes += block->bytes + IMAGE_HEADER;
+        keep = 1;
+    }
+    IMAGE_POOL_UNLOCK();
+
+    if (!keep) imageBlockDestroy(block);
+}
+
+/* Kembalikan buffer idle ke OS sampai total <= maxBytes (class terbesar dulu) */
+static void imagePoolTrimTo(size_t maxBytes) {
+    ImageBlock *release = NULL;
+    int c;
+
+    IMAGE_POOL_LOCK();
+    for (c = IMAGE_NUM_CLASSES - 1; c >= 0 && imagePoolCounters.cachedBytes > maxBytes; c--) {
+        while (imagePool[c] && imagePoolCounters.cachedBytes > maxBytes) {
+            ImageBlock *block = imagePool[c];
+
+            imagePool[c] = block->next;
+            imagePoolCounters.cachedBytes -= block->bytes + IMAGE_HEADER;
+            block->next = release;
+            release = block;
+        }
+    }
+    IMAGE_POOL_UNLOCK();
+
+    while (release) {
+        ImageBlock *next = release->next;
+
+        imageBlockDestroy(release);
+        release = next;
+    }
+}
+
+/* Batas total buffer idle di pool (byte); 0 = pool mati */
+void setImagePoolLimit(size_t bytes) {
+    IMAGE_POOL_LOCK();
+    imagePoolCounters.limitBytes = bytes;
+    IMAGE_POOL_UNLOCK();
+    imagePoolTrimTo(bytes);
+}
+
+/* Lepas semua buffer idle ke OS (batas pool tidak berubah) */
+void trimImagePool(void) {
+    imagePoolTrimTo(0);
+}
+
+/* Berlaku untuk blok baru; blok di pool tetap dengan backing lamanya */
+void setImageHugePages(HugePageMode mode) {
+    IMAGE_POOL_LOCK();
+    imageHugePages = mode;
+    IMAGE_POOL_UNLOCK();
+}
+
+void getImagePoolStats(ImagePoolStats *stats) {
+    IMAGE_POOL_LOCK();
+    *stats = imagePoolCounters;
+    IMAGE_POOL_UNLOCK();
+}
+
 /* ============================================================================
  * FUNGSI UTILITAS IMAGE
  * ============================================================================ */
 
 Image* createImage(int width, int height) {
-    Image *img = (Image*)malloc(sizeof(Image));
+    Image *img;
+
+    if (width < 0 || height < 0) return NULL;
+
+    img = (Image*)malloc(sizeof(Image));
+    if (!img) return NULL;
+
+    img->width = width;
+    img->height = height;
+    img->stride = alignedStride(width, sizeof(Pixel));
+    img->data = (Pixel*)imageBufferAlloc((size_t)img->stride * height * sizeof(Pixel), 1);
+
+    if (!img->data) {
+        free(img);
+        return NULL;
+    }
+
+    return img;
+}
+
+/* Seperti createImage tapi tanpa zero-fill, untuk output yang pasti
+ * ditulis penuh oleh resize. untouched = 1 melewati pool agar halaman
+ * besar belum disentuh (first-touch NUMA oleh worker). */
+static Image* createImageBuffer(int width, int height, int untouched) {
+    Image *img;
+
+    if (width < 0 || height < 0) return NULL;
+
+    img = (Image*)malloc(sizeof(Image));
     if (!img) return NULL;
 
     img->width = width;
     img->height = height;
-    img->data = (Pixel*)calloc(width * height, sizeof(Pixel));
+    img->stride = alignedStride(width, sizeof(Pixel));
+    img->data = (Pixel*)imageBufferGet((size_t)img->stride * height * sizeof(Pixel), 0,
+                                       !untouched);
 
     if (!img->data) {
         free(img);
@@ -54,19 +388,82 @@ Image* createImage(int width, int height) {
     return img;
 }
 
+static Image* createImageUninit(int width, int height) {
+    return createImageBuffer(width, height, 0);
+}
+
+/* View ke buffer milik caller (tidak di-free oleh freeImage; jangan
+ * dipanggil pada view). stride dalam pixel, >= width. */
+Image imageView(Pixel *data, int width, int height, int stride) {
+    Image view;
+
+    view.data = data;
+    view.width = width;
+    view.height = height;
+    view.stride = stride;
+    return view;
+}
+
 void freeImage(Image *img) {
     if (img) {
-        if (img->data) free(img->data);
+        imageBufferFree(img->data);
+        free(img);
+    }
+}
+
+/* Engine 8-bit hanya punya kernel 1, 3 dan 4 channel */
+int u8ChannelsSupported(int channels) {
+    return channels == 1 || channels == 3 || channels == 4;
+}
+
+ImageU8* createImageU8(int width, int height, int channels) {
+    ImageU8 *img;
+
+    if (!u8ChannelsSupported(channels)) return NULL;
+    if (width < 0 || height < 0) return NULL;
+
+    img = (ImageU8*)malloc(sizeof(ImageU8));
+    if (!img) return NULL;
+
+    img->width = width;
+    img->height = height;
+    img->channels = channels;
+    img->stride = alignedStride(width, channels) * channels;
+    img->data = (uint8_t*)imageBufferAlloc((size_t)img->stride * height, 1);
+
+    if (!img->data) {
+        free(img);
+        return NULL;
+    }
+
+    return img;
+}
+
+void freeImageU8(ImageU8 *img) {
+    if (img) {
+        imageBufferFree(img->data);
         free(img);
     }
 }
 
+/* View 8-bit ke buffer milik caller; stride dalam byte */
+ImageU8 imageU8View(uint8_t *data, int width, int height, int channels, int stride) {
+    ImageU8 view;
+
+    view.data = data;
+    view.width = width;
+    view.height = height;
+    view.channels = channels;
+    view.stride = stride;
+    return view;
+}
+
 Pixel getPixel(const Image *img, int x, int y) {
-    return img->data[y * img->width + x];
+    return img->data[y * img->stride + x];
 }
 
 void setPixel(Image *img, int x, int y, Pixel p) {
-    img->data[y * img->width + x] = p;
+    img->data[y * img->stride + x] = p;
 }
 
 /* ============================================================================
@@ -83,6 +480,289 @@ int mini(int a, int b) {
     return (a < b) ? a : b;
 }
 
+/* ============================================================================
+ * INSTRUMENTASI (opsional, compile dengan -DRESIZE_INSTRUMENT)
+ * ============================================================================
+ * Tanpa flag semua makro INSTR_* kosong, hot path tidak berubah.
+ * Dengan flag, setiap region engine resize (serial atau paralel) mencatat:
+ *   - busy per thread = awal..akhir bagian loop thread itu, idle = sisa
+ *     wall-clock region (fork, tunggu barrier, load imbalance)
+ *   - fase: alokasi output, pembuatan plan, compute (wall region)
+ *   - counter hardware per thread via perf_event_open (Linux, jika
+ *     perf_event_paranoid mengizinkan): cycles, instructions, cache
+ *     references/misses, hanya user space
+ * Angka diakumulasi global sampai resizeProfileReset(); laporan JSON
+ * lewat resizeProfileWriteJson(). Slot thread = omp_get_thread_num(),
+ * jadi pemanggil serial yang berjalan bersamaan berbagi slot 0.
+ */
+
+#ifdef RESIZE_INSTRUMENT
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <linux/perf_event.h>
+#define HAVE_PERF_EVENTS 1
+#endif
+
+#define INSTR_MAX_THREADS 256
+
+typedef enum { PHASE_ALLOC, PHASE_PLAN, PHASE_COMPUTE, NUM_PHASES } InstrPhase;
+
+typedef enum {
+    COUNTER_CYCLES, COUNTER_INSTRUCTIONS, COUNTER_CACHE_REFS, COUNTER_CACHE_MISSES,
+    NUM_COUNTERS
+} InstrCounter;
+
+typedef struct {
+    double busyMs[INSTR_MAX_THREADS];
+    double idleMs[INSTR_MAX_THREADS];
+    long long pixels[INSTR_MAX_THREADS];    /* pixel tujuan per slot thread */
+    int numSlots;                           /* slot tertinggi yang dipakai + 1 */
+    double phaseMs[NUM_PHASES];
+    long long regions;
+    long long totalPixels;
+    uint64_t counters[NUM_COUNTERS];
+    long long spans, countedSpans;          /* span total / dengan counter valid */
+} ResizeProfile;
+
+/* Satu region: diisi thread peserta, dilipat ke profil global di akhir */
+typedef struct {
+    double start;
+    int team;
+    double begin[INSTR_MAX_THREADS];
+    double end[INSTR_MAX_THREADS];
+    long long pixels[INSTR_MAX_THREADS];
+    uint64_t counters[NUM_COUNTERS];
+    int spans, countedSpans;
+} InstrRegion;
+
+typedef struct {
+    int slot;
+    double t0;
+    long long pixels;
+    int counting;
+    uint64_t c0[NUM_COUNTERS];
+} InstrSpan;
+
+static ResizeProfile resizeProfile;
+
+#ifdef HAVE_PTHREADS
+static pthread_mutex_t resizeProfileLock = PTHREAD_MUTEX_INITIALIZER;
+#define INSTR_LOCK()   pthread_mutex_lock(&resizeProfileLock)
+#define INSTR_UNLOCK() pthread_mutex_unlock(&resizeProfileLock)
+#else
+#define INSTR_LOCK()   ((void)0)
+#define INSTR_UNLOCK() ((void)0)
+#endif
+
+static double instrNowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1.0e6;
+}
+
+static int instrSlot(void) {
+#ifdef USE_OPENMP
+    int slot = omp_get_thread_num();
+    return slot < INSTR_MAX_THREADS ? slot : INSTR_MAX_THREADS - 1;
+#else
+    return 0;
+#endif
+}
+
+#ifdef HAVE_PERF_EVENTS
+/* Group counter per thread, dibuka sekali saat span pertama thread itu.
+ * -1 = belum dibuka, -2 = tidak tersedia (permission / PMU virtual) */
+static __thread int instrPerfFd = -1;
+
+static int instrPerfOpen(void) {
+    static const uint64_t configs[NUM_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES
+    };
+    int fds[NUM_COUNTERS];
+    int i, j;
+
+    for (i = 0; i < NUM_COUNTERS; i++) {
+        struct perf_event_attr attr;
+
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = (i == 0);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, i ? fds[0] : -1, 0);
+        if (fds[i] < 0) {
+            for (j = 0; j < i; j++) close(fds[j]);
+            return -2;
+        }
+    }
+    ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return fds[0];
+}
+
+static int instrPerfRead(uint64_t *values) {
+    struct { uint64_t nr; uint64_t values[NUM_COUNTERS]; } buf;
+    int i;
+
+    if (instrPerfFd == -1) instrPerfFd = instrPerfOpen();
+    if (instrPerfFd < 0) return 0;
+    if (read(instrPerfFd, &buf, sizeof(buf)) != (ssize_t)sizeof(buf) || buf.nr != NUM_COUNTERS)
+        return 0;
+    for (i = 0; i < NUM_COUNTERS; i++) values[i] = buf.values[i];
+    return 1;
+}
+#else
+static int instrPerfRead(uint64_t *values) {
+    (void)values;
+    return 0;
+}
+#endif
+
+static void instrRegionBegin(InstrRegion *r) {
+    memset(r, 0, sizeof(*r));
+    r->start = instrNowMs();
+}
+
+static void instrSpanBegin(InstrSpan *s) {
+    s->slot = instrSlot();
+    s->pixels = 0;
+    s->counting = instrPerfRead(s->c0);
+    s->t0 = instrNowMs();
+}
+
+static void instrSpanEnd(InstrRegion *r, InstrSpan *s) {
+    double t1 = instrNowMs();
+    uint64_t c1[NUM_COUNTERS];
+    int i, counted = s->counting && instrPerfRead(c1);
+
+    r->begin[s->slot] = s->t0;
+    r->end[s->slot] = t1;
+    r->pixels[s->slot] = s->pixels;
+    if (counted) {
+        for (i = 0; i < NUM_COUNTERS; i++)
+            __atomic_fetch_add(&r->counters[i], c1[i] - s->c0[i], __ATOMIC_RELAXED);
+        __atomic_fetch_add(&r->countedSpans, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&r->spans, 1, __ATOMIC_RELAXED);
+    for (i = __atomic_load_n(&r->team, __ATOMIC_RELAXED); i < s->slot + 1; ) {
+        if (__atomic_compare_exchange_n(&r->team, &i, s->slot + 1, 0,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            break;
+    }
+}
+
+static void instrRegionEnd(InstrRegion *r) {
+    double wall = instrNowMs() - r->start;
+    int i;
+
+    INSTR_LOCK();
+    for (i = 0; i < r->team; i++) {
+        double busy = r->end[i] - r->begin[i];
+
+        resizeProfile.busyMs[i] += busy;
+        resizeProfile.idleMs[i] += wall - busy;
+        resizeProfile.pixels[i] += r->pixels[i];
+        resizeProfile.totalPixels += r->pixels[i];
+    }
+    if (r->team > resizeProfile.numSlots) resizeProfile.numSlots = r->team;
+    for (i = 0; i < NUM_COUNTERS; i++) resizeProfile.counters[i] += r->counters[i];
+    resizeProfile.spans += r->spans;
+    resizeProfile.countedSpans += r->countedSpans;
+    resizeProfile.phaseMs[PHASE_COMPUTE] += wall;
+    resizeProfile.regions++;
+    INSTR_UNLOCK();
+}
+
+static void instrPhaseAdd(InstrPhase phase, double ms) {
+    INSTR_LOCK();
+    resizeProfile.phaseMs[phase] += ms;
+    INSTR_UNLOCK();
+}
+
+void resizeProfileReset(void) {
+    INSTR_LOCK();
+    memset(&resizeProfile, 0, sizeof(resizeProfile));
+    INSTR_UNLOCK();
+}
+
+void resizeProfileSnapshot(ResizeProfile *out) {
+    INSTR_LOCK();
+    *out = resizeProfile;
+    INSTR_UNLOCK();
+}
+
+/* Laporan JSON satu objek. load_imbalance = busy maks / busy rata-rata
+ * (1.0 = rata), idle_fraction = idle / (busy + idle) semua thread.
+ * counters = null jika perf_event tidak tersedia; coverage < 1 berarti
+ * sebagian span tidak terhitung sehingga rasio per pixel hanya perkiraan. */
+void resizeProfileWriteJson(FILE *out, const ResizeProfile *p) {
+    double busySum = 0.0, idleSum = 0.0, busyMax = 0.0;
+    int i;
+
+    for (i = 0; i < p->numSlots; i++) {
+        busySum += p->busyMs[i];
+        idleSum += p->idleMs[i];
+        if (p->busyMs[i] > busyMax) busyMax = p->busyMs[i];
+    }
+
+    fprintf(out, "{\"regions\": %lld, \"pixels\": %lld, ", p->regions, p->totalPixels);
+    fprintf(out, "\"phase_ms\": {\"alloc\": %.4f, \"plan\": %.4f, \"compute\": %.4f}, ",
+            p->phaseMs[PHASE_ALLOC], p->phaseMs[PHASE_PLAN], p->phaseMs[PHASE_COMPUTE]);
+    fprintf(out, "\"threads\": [");
+    for (i = 0; i < p->numSlots; i++) {
+        fprintf(out, "%s{\"thread\": %d, \"busy_ms\": %.4f, \"idle_ms\": %.4f, \"pixels\": %lld}",
+                i ? ", " : "", i, p->busyMs[i], p->idleMs[i], p->pixels[i]);
+    }
+    fprintf(out, "], \"load_imbalance\": %.4f, \"idle_fraction\": %.4f, ",
+            busySum > 0.0 ? busyMax * p->numSlots / busySum : 0.0,
+            busySum + idleSum > 0.0 ? idleSum / (busySum + idleSum) : 0.0);
+
+    if (p->countedSpans == 0) {
+        fprintf(out, "\"counters\": null}");
+        return;
+    }
+    fprintf(out, "\"counters\": {\"cycles\": %llu, \"instructions\": %llu, "
+            "\"cache_references\": %llu, \"cache_misses\": %llu, "
+            "\"cycles_per_pixel\": %.3f, \"ipc\": %.3f, \"cache_miss_rate\": %.4f, "
+            "\"coverage\": %.3f}}",
+            (unsigned long long)p->counters[COUNTER_CYCLES],
+            (unsigned long long)p->counters[COUNTER_INSTRUCTIONS],
+            (unsigned long long)p->counters[COUNTER_CACHE_REFS],
+            (unsigned long long)p->counters[COUNTER_CACHE_MISSES],
+            p->totalPixels ? (double)p->counters[COUNTER_CYCLES] / p->totalPixels : 0.0,
+            p->counters[COUNTER_CYCLES]
+                ? (double)p->counters[COUNTER_INSTRUCTIONS] / p->counters[COUNTER_CYCLES] : 0.0,
+            p->counters[COUNTER_CACHE_REFS]
+                ? (double)p->counters[COUNTER_CACHE_MISSES] / p->counters[COUNTER_CACHE_REFS] : 0.0,
+            (double)p->countedSpans / p->spans);
+}
+
+/* Region dideklarasikan di luar blok paralel (shared), span di dalam (private) */
+#define INSTR_REGION_BEGIN(r)       InstrRegion r; instrRegionBegin(&r)
+#define INSTR_REGION_END(r)         instrRegionEnd(&r)
+#define INSTR_SPAN_BEGIN(s)         InstrSpan s; instrSpanBegin(&s)
+#define INSTR_SPAN_PIXELS(s, n)     ((s).pixels += (n))
+#define INSTR_SPAN_END(r, s)        instrSpanEnd(&r, &s)
+#define INSTR_PHASE_BEGIN(t)        double t = instrNowMs()
+#define INSTR_PHASE_END(t, phase)   instrPhaseAdd(phase, instrNowMs() - (t))
+
+#else
+
+#define INSTR_REGION_BEGIN(r)
+#define INSTR_REGION_END(r)
+#define INSTR_SPAN_BEGIN(s)
+#define INSTR_SPAN_PIXELS(s, n)
+#define INSTR_SPAN_END(r, s)
+#define INSTR_PHASE_BEGIN(t)
+#define INSTR_PHASE_END(t, phase)
+
+#endif /* RESIZE_INSTRUMENT */
+
 /* ============================================================================
  * BILINEAR INTERPOLATION (Core Algorithm)
  * ============================================================================ */
@@ -137,14 +817,18 @@ Image* resizeSerial(const Image *source, int newWidth, int newHeight) {
     Image *dest;
     float scaleX, scaleY;
     int x, y;
+    INSTR_PHASE_BEGIN(allocStart);
 
-    dest = createImage(newWidth, newHeight);
+    dest = createImageUninit(newWidth, newHeight);
     if (!dest) return NULL;
+    INSTR_PHASE_END(allocStart, PHASE_ALLOC);
 
     scaleX = (float)source->width / newWidth;
     scaleY = (float)source->height / newHeight;
 
     /* Loop serial - sequential */
+    INSTR_REGION_BEGIN(region);
+    INSTR_SPAN_BEGIN(span);
     for (y = 0; y < newHeight; y++) {
         for (x = 0; x < newWidth; x++) {
             float srcX = x * scaleX;
@@ -152,7 +836,10 @@ Image* resizeSerial(const Image *source, int newWidth, int newHeight) {
             Pixel p = bilinearInterpolate(source, srcX, srcY);
             setPixel(dest, x, y, p);
         }
+        INSTR_SPAN_PIXELS(span, newWidth);
     }
+    INSTR_SPAN_END(region, span);
+    INSTR_REGION_END(region);
 
     return dest;
 }
@@ -167,129 +854,6673 @@ Image* resizeOpenMP(const Image *source, int newWidth, int newHeight, int numThr
     float scaleX, scaleY;
     int x, y;
 
-    dest = createImage(newWidth, newHeight);
+    INSTR_PHASE_BEGIN(allocStart);
+
+    dest = createImageUninit(newWidth, newHeight);
     if (!dest) return NULL;
+    INSTR_PHASE_END(allocStart, PHASE_ALLOC);
 
     scaleX = (float)source->width / newWidth;
     scaleY = (float)source->height / newHeight;
 
-    omp_set_num_threads(numThreads);
+    /* Loop parallel dengan OpenMP (num_threads per region, tanpa mengubah
+     * state global omp_set_num_threads). parallel + for nowait setara
+     * dengan parallel for; bentuk ini memberi titik awal/akhir per thread
+     * untuk instrumentasi (barrier tetap ada di akhir region). */
+    INSTR_REGION_BEGIN(region);
+    #pragma omp parallel private(x, y) num_threads(numThreads)
+    {
+        INSTR_SPAN_BEGIN(span);
 
-    /* Loop parallel dengan OpenMP */
-    #pragma omp parallel for collapse(2) private(x, y)
-    for (y = 0; y < newHeight; y++) {
-        for (x = 0; x < newWidth; x++) {
-            float srcX = x * scaleX;
-            float srcY = y * scaleY;
-            Pixel p = bilinearInterpolate(source, srcX, srcY);
-            setPixel(dest, x, y, p);
+        #pragma omp for collapse(2) nowait
+        for (y = 0; y < newHeight; y++) {
+            for (x = 0; x < newWidth; x++) {
+                float srcX = x * scaleX;
+                float srcY = y * scaleY;
+                Pixel p = bilinearInterpolate(source, srcX, srcY);
+                setPixel(dest, x, y, p);
+                INSTR_SPAN_PIXELS(span, 1);
+            }
         }
+
+        INSTR_SPAN_END(region, span);
     }
+    INSTR_REGION_END(region);
 
     return dest;
 }
 #endif
 
 /* ============================================================================
- * CREATE TEST IMAGE
- * ============================================================================ */
+ * RESIZE PLAN (Precomputed koordinat & bobot)
+ * ============================================================================
+ * x0/x1/fx hanya bergantung pada kolom tujuan, y0/y1/fy hanya pada baris.
+ * Plan dihitung sekali per geometri (srcW, srcH, dstW, dstH) lalu dipakai
+ * ulang, sehingga loop per pixel tinggal load + multiply-add.
+ *
+ * Border ditangani eksplisit: koordinat >= (size - 1) dipetakan ke pixel
+ * terakhir dengan fraksi 0, menggantikan clamp "- 1.001f".
+ */
 
-Image* createTestImage(int size) {
-    Image *img;
-    int x, y;
+#define FIXED_SHIFT 14
+#define FIXED_ONE   (1 << FIXED_SHIFT)
 
-    img = createImage(size, size);
-    if (!img) return NULL;
+/* Rasio eksak (sama di kedua sumbu), dideteksi saat plan dibuat:
+ * DECIMATE: src = n * dst (n = 1 identity), semua fraksi 0 -> salin pixel
+ * UPSAMPLE: dst = n * src, n = 2 atau 4 -> bobot tetap j/n, tanpa tabel */
+typedef enum { RATIO_GENERAL, RATIO_DECIMATE, RATIO_UPSAMPLE } ResizeRatio;
 
-    /* Isi dengan gradient pattern */
-    for (y = 0; y < size; y++) {
-        for (x = 0; x < size; x++) {
-            float val = (float)((x + y) % 256);
-            Pixel p;
-            p.r = val;
-            p.g = val;
-            p.b = val;
-            setPixel(img, x, y, p);
+typedef struct {
+    int srcWidth, srcHeight;
+    int dstWidth, dstHeight;
+    int   *xIndex0;     /* [dstWidth]  kolom kiri  */
+    int   *xIndex1;     /* [dstWidth]  kolom kanan */
+    float *xFrac;       /* [dstWidth]  fraksi horizontal */
+    int   *yIndex0;     /* [dstHeight] baris atas  */
+    int   *yIndex1;     /* [dstHeight] baris bawah */
+    float *yFrac;       /* [dstHeight] fraksi vertikal */
+
+    /* Tabel per lane float (3 * dstWidth): offset r/g/b di baris sumber,
+     * dipakai kernel gather AVX2/AVX-512 */
+    int   *laneIndex0;
+    int   *laneIndex1;
+    float *laneFrac;
+
+    /* Bobot fixed-point Q14 (fraksi * 16384) untuk path 8-bit */
+    int16_t *xWeightQ14;
+    int16_t *yWeightQ14;
+
+    ResizeRatio ratio;
+    int ratioFactor;    /* n untuk DECIMATE/UPSAMPLE, 0 untuk GENERAL */
+
+    /* Plan cache: referensi aktif, 1 = masih terdaftar di cache */
+    int refs;
+    int cached;
+} ResizePlan;
+
+static void buildAxisTable(int srcSize, int dstSize,
+                           int *index0, int *index1, float *frac) {
+    float scale = (float)srcSize / dstSize;
+    int i;
+
+    for (i = 0; i < dstSize; i++) {
+        float src = i * scale;
+
+        if (src >= (float)(srcSize - 1)) {
+            /* Border: pixel terakhir, tanpa tetangga kanan/bawah */
+            index0[i] = srcSize - 1;
+            index1[i] = srcSize - 1;
+            frac[i] = 0.0f;
+        } else {
+            index0[i] = (int)src;
+            index1[i] = index0[i] + 1;
+            frac[i] = src - (float)index0[i];
         }
     }
-
-    return img;
 }
 
-/* ============================================================================
- * BENCHMARK FUNCTION
- * ============================================================================ */
+/* Top-left mapping src = i * (S / D): untuk D = S / n koordinat selalu
+ * bilangan bulat; untuk D = n * S (n pangkat 2) fraksi tepat j / n.
+ * Keduanya eksak di float selama ukuran < 2^24. */
+static void classifyRatio(ResizePlan *plan) {
+    int sw = plan->srcWidth, sh = plan->srcHeight;
+    int dw = plan->dstWidth, dh = plan->dstHeight;
 
-void runBenchmark() {
-    int testSizes[] = {512, 1024, 2048};
-    int numTests = 3;
-    int targetSize = 2048;
-    int t, i;
+    plan->ratio = RATIO_GENERAL;
+    plan->ratioFactor = 0;
+
+    if (sw >= (1 << 24) || sh >= (1 << 24) || dw >= (1 << 24) || dh >= (1 << 24))
+        return;
+
+    if (sw % dw == 0 && sh % dh == 0 && sw / dw == sh / dh) {
+        plan->ratio = RATIO_DECIMATE;
+        plan->ratioFactor = sw / dw;
+    } else if ((dw == 2 * sw && dh == 2 * sh) || (dw == 4 * sw && dh == 4 * sh)) {
+        plan->ratio = RATIO_UPSAMPLE;
+        plan->ratioFactor = dw / sw;
+    }
+}
+
+void freeResizePlan(ResizePlan *plan) {
+    if (plan) {
+        free(plan->xIndex0);
+        free(plan->xIndex1);
+        free(plan->xFrac);
+        free(plan->yIndex0);
+        free(plan->yIndex1);
+        free(plan->yFrac);
+        free(plan->laneIndex0);
+        free(plan->laneIndex1);
+        free(plan->laneFrac);
+        free(plan->xWeightQ14);
+        free(plan->yWeightQ14);
+        free(plan);
+    }
+}
+
+ResizePlan* createResizePlan(int srcWidth, int srcHeight, int dstWidth, int dstHeight) {
+    ResizePlan *plan;
+    int x, y, c;
+    INSTR_PHASE_BEGIN(planStart);
+
+    if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0)
+        return NULL;
+
+    plan = (ResizePlan*)malloc(sizeof(ResizePlan));
+    if (!plan) return NULL;
+
+    plan->srcWidth = srcWidth;
+    plan->srcHeight = srcHeight;
+    plan->dstWidth = dstWidth;
+    plan->dstHeight = dstHeight;
+    plan->refs = 0;
+    plan->cached = 0;
+
+    plan->xIndex0 = (int*)malloc(dstWidth * sizeof(int));
+    plan->xIndex1 = (int*)malloc(dstWidth * sizeof(int));
+    plan->xFrac = (float*)malloc(dstWidth * sizeof(float));
+    plan->yIndex0 = (int*)malloc(dstHeight * sizeof(int));
+    plan->yIndex1 = (int*)malloc(dstHeight * sizeof(int));
+    plan->yFrac = (float*)malloc(dstHeight * sizeof(float));
+    plan->laneIndex0 = (int*)malloc(3 * dstWidth * sizeof(int));
+    plan->laneIndex1 = (int*)malloc(3 * dstWidth * sizeof(int));
+    plan->laneFrac = (float*)malloc(3 * dstWidth * sizeof(float));
+    plan->xWeightQ14 = (int16_t*)malloc(dstWidth * sizeof(int16_t));
+    plan->yWeightQ14 = (int16_t*)malloc(dstHeight * sizeof(int16_t));
+
+    if (!plan->xIndex0 || !plan->xIndex1 || !plan->xFrac ||
+        !plan->yIndex0 || !plan->yIndex1 || !plan->yFrac ||
+        !plan->laneIndex0 || !plan->laneIndex1 || !plan->laneFrac ||
+        !plan->xWeightQ14 || !plan->yWeightQ14) {
+        freeResizePlan(plan);
+        return NULL;
+    }
+
+    buildAxisTable(srcWidth, dstWidth, plan->xIndex0, plan->xIndex1, plan->xFrac);
+    buildAxisTable(srcHeight, dstHeight, plan->yIndex0, plan->yIndex1, plan->yFrac);
+
+    for (y = 0; y < dstHeight; y++) {
+        plan->yWeightQ14[y] = (int16_t)lrintf(plan->yFrac[y] * FIXED_ONE);
+    }
+    for (x = 0; x < dstWidth; x++) {
+        plan->xWeightQ14[x] = (int16_t)lrintf(plan->xFrac[x] * FIXED_ONE);
+        for (c = 0; c < 3; c++) {
+            plan->laneIndex0[3 * x + c] = 3 * plan->xIndex0[x] + c;
+            plan->laneIndex1[3 * x + c] = 3 * plan->xIndex1[x] + c;
+            plan->laneFrac[3 * x + c] = plan->xFrac[x];
+        }
+    }
+
+    classifyRatio(plan);
+    INSTR_PHASE_END(planStart, PHASE_PLAN);
+    return plan;
+}
+
+/* Sub-plan untuk kolom tujuan [x0, x0 + width): berbagi tabel plan asli.
+ * Index sumber tetap absolut, jadi kernel membaca baris sumber utuh. */
+static ResizePlan planColumnWindow(const ResizePlan *plan, int x0, int width) {
+    ResizePlan sub = *plan;
+
+    sub.ratio = RATIO_GENERAL;
+    sub.dstWidth = width;
+    sub.xIndex0 += x0;
+    sub.xIndex1 += x0;
+    sub.xFrac += x0;
+    sub.xWeightQ14 += x0;
+    sub.laneIndex0 += 3 * x0;
+    sub.laneIndex1 += 3 * x0;
+    sub.laneFrac += 3 * x0;
+    return sub;
+}
+
+/* Sub-plan untuk baris tujuan [y0, y0 + height) */
+static ResizePlan planRowWindow(const ResizePlan *plan, int y0, int height) {
+    ResizePlan sub = *plan;
+
+    sub.ratio = RATIO_GENERAL;
+    sub.dstHeight = height;
+    sub.yIndex0 += y0;
+    sub.yIndex1 += y0;
+    sub.yFrac += y0;
+    sub.yWeightQ14 += y0;
+    return sub;
+}
+
+/* ============================================================================
+ * PLAN CACHE (LRU, thread-safe)
+ * ============================================================================
+ * Service jangka panjang memakai segelintir geometri yang sama berulang
+ * kali, jadi plan disimpan per (srcW, srcH, dstW, dstH) dan dipakai ulang.
+ * acquireResizePlan menaikkan refcount, releaseResizePlan menurunkannya.
+ * Entri LRU yang terbuang saat cache penuh baru di-free setelah referensi
+ * terakhir dilepas, sehingga plan yang sedang dipakai thread lain tetap
+ * valid. Plan read-only setelah dibuat dan boleh dipakai bersamaan.
+ * Isi plan: tabel index/bobot, tabel Q14 8-bit dan klasifikasi fast path.
+ */
+
+#define PLAN_CACHE_MAX              64
+#define DEFAULT_PLAN_CACHE_CAPACITY 32
+
+typedef struct {
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+    int entries;
+    int capacity;
+} PlanCacheStats;
+
+typedef struct {
+    ResizePlan *plan;
+    unsigned long long lastUse;
+} PlanCacheEntry;
+
+static PlanCacheEntry planCache[PLAN_CACHE_MAX];
+static int planCacheCount = 0;
+static int planCacheCapacity = DEFAULT_PLAN_CACHE_CAPACITY;
+static unsigned long long planCacheTick = 0;
+static PlanCacheStats planCacheCounters;
+
+#ifdef HAVE_PTHREADS
+static pthread_mutex_t planCacheLock = PTHREAD_MUTEX_INITIALIZER;
+#define PLAN_CACHE_LOCK()   pthread_mutex_lock(&planCacheLock)
+#define PLAN_CACHE_UNLOCK() pthread_mutex_unlock(&planCacheLock)
+#else
+#define PLAN_CACHE_LOCK()   ((void)0)
+#define PLAN_CACHE_UNLOCK() ((void)0)
+#endif
+
+/* Dipanggil dengan lock; return plan cache dengan geometri ini (refcount
+ * sudah dinaikkan) atau NULL */
+static ResizePlan* planCacheLookup(int srcWidth, int srcHeight, int dstWidth, int dstHeight) {
+    int i;
+
+    for (i = 0; i < planCacheCount; i++) {
+        ResizePlan *plan = planCache[i].plan;
+
+        if (plan->srcWidth == srcWidth && plan->srcHeight == srcHeight &&
+            plan->dstWidth == dstWidth && plan->dstHeight == dstHeight) {
+            planCache[i].lastUse = ++planCacheTick;
+            plan->refs++;
+            return plan;
+        }
+    }
+    return NULL;
+}
+
+/* Dipanggil dengan lock; buang entri i, plan di-free jika tidak dipakai */
+static void planCacheEvict(int i) {
+    ResizePlan *plan = planCache[i].plan;
+
+    plan->cached = 0;
+    if (plan->refs == 0) freeResizePlan(plan);
+    planCache[i] = planCache[--planCacheCount];
+    planCacheCounters.evictions++;
+}
+
+static int planCacheLeastRecent(void) {
+    int i, victim = 0;
+
+    for (i = 1; i < planCacheCount; i++) {
+        if (planCache[i].lastUse < planCache[victim].lastUse) victim = i;
+    }
+    return victim;
+}
+
+/* Plan untuk geometri ini dari cache (dibuat jika belum ada). Wajib
+ * dilepas dengan releaseResizePlan, jangan freeResizePlan. NULL jika
+ * ukuran tidak valid atau alokasi gagal. */
+const ResizePlan* acquireResizePlan(int srcWidth, int srcHeight, int dstWidth, int dstHeight) {
+    ResizePlan *plan, *existing;
+
+    PLAN_CACHE_LOCK();
+    plan = planCacheLookup(srcWidth, srcHeight, dstWidth, dstHeight);
+    if (plan) planCacheCounters.hits++;
+    else planCacheCounters.misses++;
+    PLAN_CACHE_UNLOCK();
+    if (plan) return plan;
+
+    /* Build di luar lock; thread lain bisa sedang membangun geometri sama */
+    plan = createResizePlan(srcWidth, srcHeight, dstWidth, dstHeight);
+    if (!plan) return NULL;
+
+    PLAN_CACHE_LOCK();
+    existing = planCacheLookup(srcWidth, srcHeight, dstWidth, dstHeight);
+    if (!existing) {
+        plan->refs = 1;
+        if (planCacheCapacity > 0) {
+            if (planCacheCount >= planCacheCapacity) planCacheEvict(planCacheLeastRecent());
+            planCache[planCacheCount].plan = plan;
+            planCache[planCacheCount].lastUse = ++planCacheTick;
+            planCacheCount++;
+            plan->cached = 1;
+        }
+    }
+    PLAN_CACHE_UNLOCK();
+
+    if (existing) {
+        freeResizePlan(plan);
+        return existing;
+    }
+    return plan;
+}
+
+void releaseResizePlan(const ResizePlan *plan) {
+    ResizePlan *p = (ResizePlan*)plan;
+    int drop;
+
+    if (!p) return;
+
+    PLAN_CACHE_LOCK();
+    drop = (--p->refs == 0 && !p->cached);
+    PLAN_CACHE_UNLOCK();
+
+    if (drop) freeResizePlan(p);
+}
+
+/* Kapasitas 0..PLAN_CACHE_MAX; 0 = cache mati (plan dibuat per acquire).
+ * Mengecilkan kapasitas membuang entri paling lama tidak dipakai. */
+void setPlanCacheCapacity(int capacity) {
+    if (capacity < 0) capacity = 0;
+    if (capacity > PLAN_CACHE_MAX) capacity = PLAN_CACHE_MAX;
+
+    PLAN_CACHE_LOCK();
+    planCacheCapacity = capacity;
+    while (planCacheCount > capacity) planCacheEvict(planCacheLeastRecent());
+    PLAN_CACHE_UNLOCK();
+}
+
+void getPlanCacheStats(PlanCacheStats *stats) {
+    PLAN_CACHE_LOCK();
+    *stats = planCacheCounters;
+    stats->entries = planCacheCount;
+    stats->capacity = planCacheCapacity;
+    PLAN_CACHE_UNLOCK();
+}
+
+/* ============================================================================
+ * SIMD KERNELS & RUNTIME DISPATCH
+ * ============================================================================
+ * Setiap baris tujuan = 2 pass:
+ *   horizontal: top[j] = a + fx * (b - a)   (baris y0 dan y1)
+ *   vertikal:   out[j] = top + fy * (bot - top)
+ * j adalah lane float (r, g, b interleaved), jadi satu baris = 3 * dstWidth lane.
+ *
+ * Toleransi: semua varian menjalankan operasi IEEE single yang sama dengan
+ * urutan yang sama (mul lalu add, tanpa FMA), sehingga hasilnya bit-identik
+ * dengan kernel scalar (selisih 0) pada flag Makefile (-std=c99 mematikan
+ * FP contraction). Jika dikompilasi dengan contraction aktif (mis.
+ * -std=gnu99 -march=native) kernel scalar bisa memakai FMA; selisihnya
+ * tetap < 1e-4 untuk data 0-255.
+ */
+
+typedef char pixelIsThreeFloats[(sizeof(Pixel) == 3 * sizeof(float)) ? 1 : -1];
+
+typedef void (*HorizontalKernel)(const float *srcRow, const ResizePlan *plan, float *out);
+typedef void (*VerticalKernel)(const float *top, const float *bot, float fy,
+                               float *out, int count);
+
+typedef struct {
+    const char *name;
+    HorizontalKernel horizontal;
+    VerticalKernel vertical;
+} ResizeKernels;
+
+static void horizontalScalar(const float *srcRow, const ResizePlan *plan, float *out) {
+    int x;
+
+    for (x = 0; x < plan->dstWidth; x++) {
+        const float *a = srcRow + 3 * plan->xIndex0[x];
+        const float *b = srcRow + 3 * plan->xIndex1[x];
+        float fx = plan->xFrac[x];
+
+        out[3 * x + 0] = a[0] + fx * (b[0] - a[0]);
+        out[3 * x + 1] = a[1] + fx * (b[1] - a[1]);
+        out[3 * x + 2] = a[2] + fx * (b[2] - a[2]);
+    }
+}
+
+static void verticalScalar(const float *top, const float *bot, float fy,
+                           float *out, int count) {
+    int j;
+
+    for (j = 0; j < count; j++) {
+        out[j] = top[j] + fy * (bot[j] - top[j]);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+/* SSE4.1: 1 pixel per iterasi, load 4 float (r,g,b + r berikutnya) dan
+ * store 4 float; lane ke-4 ditimpa pixel berikutnya. Pixel yang membaca
+ * kolom terakhir sumber atau menulis pixel terakhir ditangani scalar. */
+__attribute__((target("sse4.1")))
+static void horizontalSse41(const float *srcRow, const ResizePlan *plan, float *out) {
+    int x = 0;
+    int lastSrc = plan->srcWidth - 1;
+
+    for (; x < plan->dstWidth - 1 && plan->xIndex1[x] < lastSrc; x++) {
+        __m128 a = _mm_loadu_ps(srcRow + 3 * plan->xIndex0[x]);
+        __m128 b = _mm_loadu_ps(srcRow + 3 * plan->xIndex1[x]);
+        __m128 fx = _mm_set1_ps(plan->xFrac[x]);
+
+        _mm_storeu_ps(out + 3 * x, _mm_add_ps(a, _mm_mul_ps(fx, _mm_sub_ps(b, a))));
+    }
+
+    for (; x < plan->dstWidth; x++) {
+        const float *a = srcRow + 3 * plan->xIndex0[x];
+        const float *b = srcRow + 3 * plan->xIndex1[x];
+        float fx = plan->xFrac[x];
+
+        out[3 * x + 0] = a[0] + fx * (b[0] - a[0]);
+        out[3 * x + 1] = a[1] + fx * (b[1] - a[1]);
+        out[3 * x + 2] = a[2] + fx * (b[2] - a[2]);
+    }
+}
+
+__attribute__((target("sse4.1")))
+static void verticalSse41(const float *top, const float *bot, float fy,
+                          float *out, int count) {
+    __m128 w = _mm_set1_ps(fy);
+    int j = 0;
+
+    for (; j + 4 <= count; j += 4) {
+        __m128 t = _mm_loadu_ps(top + j);
+        __m128 b = _mm_loadu_ps(bot + j);
+        _mm_storeu_ps(out + j, _mm_add_ps(t, _mm_mul_ps(w, _mm_sub_ps(b, t))));
+    }
+    for (; j < count; j++) {
+        out[j] = top[j] + fy * (bot[j] - top[j]);
+    }
+}
+
+/* AVX2: 8 lane per iterasi via gather memakai tabel lane dari plan */
+__attribute__((target("avx2")))
+static void horizontalAvx2(const float *srcRow, const ResizePlan *plan, float *out) {
+    int count = 3 * plan->dstWidth;
+    int j = 0;
+
+    for (; j + 8 <= count; j += 8) {
+        __m256i i0 = _mm256_loadu_si256((const __m256i*)(plan->laneIndex0 + j));
+        __m256i i1 = _mm256_loadu_si256((const __m256i*)(plan->laneIndex1 + j));
+        __m256 fx = _mm256_loadu_ps(plan->laneFrac + j);
+        __m256 a = _mm256_i32gather_ps(srcRow, i0, 4);
+        __m256 b = _mm256_i32gather_ps(srcRow, i1, 4);
+
+        _mm256_storeu_ps(out + j, _mm256_add_ps(a, _mm256_mul_ps(fx, _mm256_sub_ps(b, a))));
+    }
+    for (; j < count; j++) {
+        float a = srcRow[plan->laneIndex0[j]];
+        float b = srcRow[plan->laneIndex1[j]];
+        out[j] = a + plan->laneFrac[j] * (b - a);
+    }
+}
+
+__attribute__((target("avx2")))
+static void verticalAvx2(const float *top, const float *bot, float fy,
+                         float *out, int count) {
+    __m256 w = _mm256_set1_ps(fy);
+    int j = 0;
+
+    for (; j + 8 <= count; j += 8) {
+        __m256 t = _mm256_loadu_ps(top + j);
+        __m256 b = _mm256_loadu_ps(bot + j);
+        _mm256_storeu_ps(out + j, _mm256_add_ps(t, _mm256_mul_ps(w, _mm256_sub_ps(b, t))));
+    }
+    for (; j < count; j++) {
+        out[j] = top[j] + fy * (bot[j] - top[j]);
+    }
+}
+
+/* AVX-512: 16 lane per iterasi, sisa lane lewat mask (tanpa loop scalar) */
+__attribute__((target("avx512f")))
+static void horizontalAvx512(const float *srcRow, const ResizePlan *plan, float *out) {
+    int count = 3 * plan->dstWidth;
+    int j;
+
+    for (j = 0; j < count; j += 16) {
+        int left = count - j;
+        __mmask16 m = (left >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << left) - 1);
+        __m512i i0 = _mm512_maskz_loadu_epi32(m, plan->laneIndex0 + j);
+        __m512i i1 = _mm512_maskz_loadu_epi32(m, plan->laneIndex1 + j);
+        __m512 fx = _mm512_maskz_loadu_ps(m, plan->laneFrac + j);
+        __m512 a = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), m, i0, srcRow, 4);
+        __m512 b = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), m, i1, srcRow, 4);
+
+        _mm512_mask_storeu_ps(out + j, m, _mm512_add_ps(a, _mm512_mul_ps(fx, _mm512_sub_ps(b, a))));
+    }
+}
+
+__attribute__((target("avx512f")))
+static void verticalAvx512(const float *top, const float *bot, float fy,
+                           float *out, int count) {
+    __m512 w = _mm512_set1_ps(fy);
+    int j;
+
+    for (j = 0; j < count; j += 16) {
+        int left = count - j;
+        __mmask16 m = (left >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << left) - 1);
+        __m512 t = _mm512_maskz_loadu_ps(m, top + j);
+        __m512 b = _mm512_maskz_loadu_ps(m, bot + j);
+        _mm512_mask_storeu_ps(out + j, m, _mm512_add_ps(t, _mm512_mul_ps(w, _mm512_sub_ps(b, t))));
+    }
+}
+#define HAVE_X86_KERNELS 1
+#endif
+
+/* Urut dari yang terbaik; index 0..N-2 hanya dipakai jika CPU mendukung */
+static const ResizeKernels kernelTable[] = {
+#ifdef HAVE_X86_KERNELS
+    { "avx512", horizontalAvx512, verticalAvx512 },
+    { "avx2",   horizontalAvx2,   verticalAvx2 },
+    { "sse4.1", horizontalSse41,  verticalSse41 },
+#endif
+    { "scalar", horizontalScalar, verticalScalar }
+};
+
+#define NUM_RESIZE_KERNELS ((int)(sizeof(kernelTable) / sizeof(kernelTable[0])))
+
+/* Cek dukungan ISA (cpuid + status XSAVE OS via __builtin_cpu_supports) */
+static int kernelSupported(const ResizeKernels *k) {
+#ifdef HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    if (k->horizontal == horizontalAvx512) return __builtin_cpu_supports("avx512f");
+    if (k->horizontal == horizontalAvx2)   return __builtin_cpu_supports("avx2");
+    if (k->horizontal == horizontalSse41)  return __builtin_cpu_supports("sse4.1");
+#endif
+    return k->horizontal == horizontalScalar;
+}
+
+/* Kernel dengan nama tertentu, atau NULL jika tidak ada / tidak didukung CPU */
+const ResizeKernels* findResizeKernels(const char *name) {
+    int i;
+
+    for (i = 0; i < NUM_RESIZE_KERNELS; i++) {
+        if (strcmp(kernelTable[i].name, name) == 0)
+            return kernelSupported(&kernelTable[i]) ? &kernelTable[i] : NULL;
+    }
+    return NULL;
+}
+
+static const ResizeKernels *activeKernels = NULL;
+
+/* Kernel terbaik untuk CPU ini, dipilih sekali saat pertama dipanggil */
+const ResizeKernels* getResizeKernels(void) {
+    const ResizeKernels *k = __atomic_load_n(&activeKernels, __ATOMIC_ACQUIRE);
+    int i;
+
+    if (k) return k;
+
+    for (i = 0; i < NUM_RESIZE_KERNELS; i++) {
+        if (kernelSupported(&kernelTable[i])) {
+            k = &kernelTable[i];
+            break;
+        }
+    }
+    __atomic_store_n(&activeKernels, k, __ATOMIC_RELEASE);
+    return k;
+}
+
+/* ============================================================================
+ * ENGINE 2-PASS DENGAN ROW CACHE
+ * ============================================================================
+ * Setiap baris sumber yang dibutuhkan di-resample horizontal tepat sekali
+ * ke ring buffer 2 baris; baris tujuan = blend vertikal 2 baris cache.
+ * Karena yIndex0/yIndex1 monoton naik, baca sumber berurutan dan kerja
+ * horizontal turun kira-kira sebesar faktor skala vertikal (upscale).
+ * Urutan operasi sama dengan kernel per baris, jadi hasil bit-identik.
+ */
+
+typedef struct {
+    float *rows[2];     /* 3 * dstWidth float per slot */
+    int srcY[2];        /* baris sumber di slot, -1 = kosong */
+} RowCache;
+
+static int initRowCache(RowCache *cache, int lanes) {
+    cache->rows[0] = (float*)malloc(2 * (size_t)lanes * sizeof(float));
+    cache->rows[1] = cache->rows[0] ? cache->rows[0] + lanes : NULL;
+    cache->srcY[0] = -1;
+    cache->srcY[1] = -1;
+    return cache->rows[0] ? 0 : -1;
+}
+
+static void freeRowCache(RowCache *cache) {
+    free(cache->rows[0]);
+}
+
+/* Resample horizontal srcRow ke cache sebagai baris srcY; slot yang diganti
+ * selalu baris terlama (index terkecil), jadi pasangan y0/y1 tidak saling buang */
+static const float* storeCachedRow(RowCache *cache, const ResizePlan *plan,
+                                   const ResizeKernels *k, int srcY, const float *srcRow) {
+    int slot = (cache->srcY[0] < cache->srcY[1]) ? 0 : 1;
+
+    k->horizontal(srcRow, plan, cache->rows[slot]);
+    cache->srcY[slot] = srcY;
+    return cache->rows[slot];
+}
+
+/* Baris sumber srcY hasil resample horizontal (dihitung jika belum ada) */
+static const float* getCachedRow(RowCache *cache, const Image *source,
+                                 const ResizePlan *plan, const ResizeKernels *k, int srcY) {
+    if (cache->srcY[0] == srcY) return cache->rows[0];
+    if (cache->srcY[1] == srcY) return cache->rows[1];
+
+    return storeCachedRow(cache, plan, k, srcY,
+                          (const float*)(source->data + (size_t)srcY * source->stride));
+}
+
+static void resizeRowCached(const Image *source, const ResizePlan *plan,
+                            const ResizeKernels *k, RowCache *cache, Pixel *out, int y) {
+    const float *top = getCachedRow(cache, source, plan, k, plan->yIndex0[y]);
+    int count = 3 * plan->dstWidth;
+
+    if (plan->yIndex1[y] == plan->yIndex0[y]) {
+        memcpy(out, top, count * sizeof(float));
+        return;
+    }
+    k->vertical(top, getCachedRow(cache, source, plan, k, plan->yIndex1[y]),
+                plan->yFrac[y], (float*)out, count);
+}
+
+static int planMatches(const ResizePlan *plan, int srcWidth, int srcHeight,
+                       int dstWidth, int dstHeight) {
+    return plan && plan->srcWidth == srcWidth && plan->srcHeight == srcHeight &&
+           plan->dstWidth == dstWidth && plan->dstHeight == dstHeight;
+}
+
+/* Tulis semua baris tujuan ke dest (stride bebas); numThreads <= 1 = serial.
+ * Paralel: schedule(static) memberi tiap thread blok baris berurutan dan
+ * row cache sendiri. caches = NULL: cache dialokasi per panggilan; selain
+ * itu caches[thread] (>= 3 * dstWidth lane, satu per thread) dipakai ulang
+ * tanpa alokasi. Return 0 sukses, -1 jika cache gagal dialokasi. */
+static int resizeRowsWithPlan(const Image *source, Image *dest, const ResizePlan *plan,
+                              const ResizeKernels *k, int numThreads, RowCache *caches) {
+    int failed = 0;
+    INSTR_REGION_BEGIN(region);
+
+#ifdef USE_OPENMP
+    if (numThreads > 1) {
+        #pragma omp parallel num_threads(numThreads)
+        {
+            RowCache cache;
+            int ok, y;
+            INSTR_SPAN_BEGIN(span);
+
+            if (caches) {
+                cache = caches[omp_get_thread_num()];
+                cache.srcY[0] = cache.srcY[1] = -1;
+                ok = 1;
+            } else {
+                ok = initRowCache(&cache, 3 * plan->dstWidth) == 0;
+            }
+
+            if (!ok) {
+                #pragma omp atomic write
+                failed = 1;
+            }
+
+            #pragma omp for schedule(static) nowait
+            for (y = 0; y < plan->dstHeight; y++) {
+                if (ok) {
+                    resizeRowCached(source, plan, k, &cache,
+                                    dest->data + (size_t)y * dest->stride, y);
+                    INSTR_SPAN_PIXELS(span, plan->dstWidth);
+                }
+            }
+
+            INSTR_SPAN_END(region, span);
+            if (!caches) freeRowCache(&cache);
+        }
+        INSTR_REGION_END(region);
+        return failed ? -1 : 0;
+    }
+#endif
+    {
+        RowCache cache;
+        int y;
+        INSTR_SPAN_BEGIN(span);
+
+        (void)numThreads;
+        if (caches) {
+            cache = caches[0];
+            cache.srcY[0] = cache.srcY[1] = -1;
+        } else if (initRowCache(&cache, 3 * plan->dstWidth) != 0) {
+            return -1;
+        }
+
+        for (y = 0; y < plan->dstHeight; y++) {
+            resizeRowCached(source, plan, k, &cache,
+                            dest->data + (size_t)y * dest->stride, y);
+            INSTR_SPAN_PIXELS(span, plan->dstWidth);
+        }
+
+        if (!caches) freeRowCache(&cache);
+        INSTR_SPAN_END(region, span);
+    }
+    INSTR_REGION_END(region);
+    return failed ? -1 : 0;
+}
+
+Image* resizeSerialPlanWith(const Image *source, const ResizePlan *plan,
+                            const ResizeKernels *k) {
+    Image *dest;
+
+    if (!k || !plan || source->width != plan->srcWidth || source->height != plan->srcHeight)
+        return NULL;
+
+    dest = createImageUninit(plan->dstWidth, plan->dstHeight);
+    if (!dest) return NULL;
+
+    if (resizeRowsWithPlan(source, dest, plan, k, 1, NULL) != 0) {
+        freeImage(dest);
+        return NULL;
+    }
+    return dest;
+}
+
+/* ============================================================================
+ * FAST PATH RASIO EKSAK (identity, 1/n, 2x, 4x)
+ * ============================================================================
+ * DECIMATE: fraksi plan semuanya 0, jadi cukup salin pixel (n*x, n*y);
+ * baris sumber di antaranya tidak dibaca sama sekali (path umum tetap
+ * meresample baris yIndex1 walau bobotnya 0). Identik dengan path umum
+ * untuk input finite; bedanya hanya -0 / NaN tetangga yang tidak ikut.
+ * UPSAMPLE: horizontal dengan bobot tetap j/n (rumus a + f*(b-a) yang sama,
+ * bit-identik), vertikal tetap lewat row cache + kernel ISA aktif.
+ */
+
+static const float upsampleWeights2[2] = { 0.0f, 0.5f };
+static const float upsampleWeights4[4] = { 0.0f, 0.25f, 0.5f, 0.75f };
+
+/* n konstan setelah inline, loop j & channel di-unroll compiler */
+static inline void horizontalUpsample(const float *srcRow, int srcWidth, int n,
+                                      const float *w, float *out) {
+    const float *a = srcRow + 3 * (srcWidth - 1);
+    int k, j, c;
+
+    for (k = 0; k < srcWidth - 1; k++) {
+        const float *p = srcRow + 3 * k;
+
+        for (j = 0; j < n; j++) {
+            for (c = 0; c < 3; c++)
+                out[3 * (n * k + j) + c] = p[c] + w[j] * (p[c + 3] - p[c]);
+        }
+    }
+    /* Border: n pixel terakhir = pixel terakhir sumber (fraksi 0) */
+    for (j = 0; j < n; j++) {
+        for (c = 0; c < 3; c++)
+            out[3 * (n * (srcWidth - 1) + j) + c] = a[c] + 0.0f * (a[c] - a[c]);
+    }
+}
+
+static void horizontalUpsample2(const float *srcRow, const ResizePlan *plan, float *out) {
+    horizontalUpsample(srcRow, plan->srcWidth, 2, upsampleWeights2, out);
+}
+
+static void horizontalUpsample4(const float *srcRow, const ResizePlan *plan, float *out) {
+    horizontalUpsample(srcRow, plan->srcWidth, 4, upsampleWeights4, out);
+}
+
+static int decimateRows(const Image *source, Image *dest, const ResizePlan *plan,
+                        int numThreads) {
+    int n = plan->ratioFactor;
+    int y;
+    INSTR_REGION_BEGIN(region);
+
+#ifdef USE_OPENMP
+    #pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+#endif
+    {
+        INSTR_SPAN_BEGIN(span);
+
+#ifdef USE_OPENMP
+        #pragma omp for schedule(static) nowait
+#endif
+        for (y = 0; y < plan->dstHeight; y++) {
+            const Pixel *src = source->data + (size_t)y * n * source->stride;
+            Pixel *out = dest->data + (size_t)y * dest->stride;
+            int x;
+
+            INSTR_SPAN_PIXELS(span, plan->dstWidth);
+            if (n == 1) {
+                memcpy(out, src, plan->dstWidth * sizeof(Pixel));
+                continue;
+            }
+            for (x = 0; x < plan->dstWidth; x++) {
+                out[x] = src[n * x];
+            }
+        }
+
+        INSTR_SPAN_END(region, span);
+    }
+    INSTR_REGION_END(region);
+    (void)numThreads;
+    return 0;
+}
+
+/* Front end plan: fast path sesuai plan->ratio, selain itu path umum
+ * dengan kernel ISA terbaik. resizeSerialPlanWith sengaja tidak lewat sini
+ * supaya perbandingan per ISA tetap mengukur kernel umum. caches seperti
+ * resizeRowsWithPlan (NULL = alokasi per panggilan). */
+static int resizeRowsAutoCached(const Image *source, Image *dest, const ResizePlan *plan,
+                                int numThreads, RowCache *caches) {
+    const ResizeKernels *k = getResizeKernels();
+
+    if (plan->ratio == RATIO_DECIMATE)
+        return decimateRows(source, dest, plan, numThreads);
+
+    if (plan->ratio == RATIO_UPSAMPLE) {
+        ResizeKernels fixed = *k;
+
+        fixed.horizontal = plan->ratioFactor == 2 ? horizontalUpsample2 : horizontalUpsample4;
+        return resizeRowsWithPlan(source, dest, plan, &fixed, numThreads, caches);
+    }
+    return resizeRowsWithPlan(source, dest, plan, k, numThreads, caches);
+}
+
+static int resizeRowsAuto(const Image *source, Image *dest, const ResizePlan *plan,
+                          int numThreads) {
+    return resizeRowsAutoCached(source, dest, plan, numThreads, NULL);
+}
+
+static Image* resizePlanAlloc(const Image *source, const ResizePlan *plan, int numThreads) {
+    Image *dest;
+    INSTR_PHASE_BEGIN(allocStart);
+
+    if (!plan || source->width != plan->srcWidth || source->height != plan->srcHeight)
+        return NULL;
+
+    dest = createImageUninit(plan->dstWidth, plan->dstHeight);
+    if (!dest) return NULL;
+    INSTR_PHASE_END(allocStart, PHASE_ALLOC);
+
+    if (resizeRowsAuto(source, dest, plan, numThreads) != 0) {
+        freeImage(dest);
+        return NULL;
+    }
+    return dest;
+}
+
+Image* resizeSerialPlan(const Image *source, const ResizePlan *plan) {
+    return resizePlanAlloc(source, plan, 1);
+}
+
+#ifdef USE_OPENMP
+Image* resizeOpenMPPlan(const Image *source, const ResizePlan *plan, int numThreads) {
+    return resizePlanAlloc(source, plan, numThreads);
+}
+#endif
+
+/* ============================================================================
+ * RESIZE INTO (Buffer tujuan milik caller)
+ * ============================================================================
+ * Tidak ada alokasi image: hasil ditulis ke dest yang sudah ada (boleh
+ * view dengan stride > width), jadi buffer bisa dipakai ulang antar
+ * request. Ukuran dest menentukan ukuran tujuan.
+ * Return 0 sukses, -1 jika ukuran tidak cocok atau alokasi scratch gagal.
+ * numThreads <= 1 (atau build tanpa OpenMP) = serial.
+ */
+
+int resizeIntoPlan(const Image *source, Image *dest, const ResizePlan *plan, int numThreads) {
+    if (!source || !dest || dest->stride < dest->width ||
+        !planMatches(plan, source->width, source->height, dest->width, dest->height))
+        return -1;
+
+    return resizeRowsAuto(source, dest, plan, numThreads);
+}
+
+int resizeInto(const Image *source, Image *dest, int numThreads) {
+    const ResizePlan *plan;
+    int status;
+
+    if (!source || !dest) return -1;
+
+    plan = acquireResizePlan(source->width, source->height, dest->width, dest->height);
+    if (!plan) return -1;
+
+    status = resizeIntoPlan(source, dest, plan, numThreads);
+    releaseResizePlan(plan);
+    return status;
+}
+
+/* ============================================================================
+ * STREAMING SCANLINE RESIZE
+ * ============================================================================
+ * Untuk raster yang tidak muat di RAM: caller push baris sumber satu per
+ * satu (urut dari atas), baris tujuan dikirim ke sink begitu lengkap.
+ * Memori = plan (O(dstWidth + dstHeight)) + 2 baris cache + 1 baris output,
+ * tidak bergantung tinggi image. Hasil bit-identik dengan resizeInto.
+ */
+
+/* Dipanggil untuk setiap baris tujuan y (urut); row valid selama callback */
+typedef void (*ScanlineSink)(void *userData, int y, const Pixel *row);
+
+/* Isi row dengan baris sumber y; return 0 sukses, selain itu = batal */
+typedef int (*ScanlineSource)(void *userData, int y, Pixel *row);
+
+typedef struct {
+    ResizePlan *plan;
+    const ResizeKernels *kernels;
+    RowCache cache;
+    Pixel *outRow;
+    ScanlineSink sink;
+    void *userData;
+    int nextSrcY;       /* jumlah baris sumber yang sudah di-push */
+    int nextDstY;       /* baris tujuan berikutnya yang akan dikirim */
+} ResizeStream;
+
+void freeResizeStream(ResizeStream *stream) {
+    if (stream) {
+        freeResizePlan(stream->plan);
+        freeRowCache(&stream->cache);
+        free(stream->outRow);
+        free(stream);
+    }
+}
+
+ResizeStream* createResizeStream(int srcWidth, int srcHeight, int dstWidth, int dstHeight,
+                                 ScanlineSink sink, void *userData) {
+    ResizeStream *stream;
+
+    if (!sink) return NULL;
+
+    stream = (ResizeStream*)calloc(1, sizeof(ResizeStream));
+    if (!stream) return NULL;
+
+    stream->plan = createResizePlan(srcWidth, srcHeight, dstWidth, dstHeight);
+    stream->outRow = (Pixel*)malloc((size_t)dstWidth * sizeof(Pixel));
+    if (!stream->plan || !stream->outRow ||
+        initRowCache(&stream->cache, 3 * dstWidth) != 0) {
+        freeResizeStream(stream);
+        return NULL;
+    }
+
+    stream->kernels = getResizeKernels();
+    stream->sink = sink;
+    stream->userData = userData;
+    return stream;
+}
+
+/* Push baris sumber berikutnya (srcWidth pixel). Baris yang tidak dipakai
+ * plan (downscale) langsung dilewati. Return 0 sukses, -1 jika semua
+ * baris sumber sudah di-push. */
+int resizeStreamPush(ResizeStream *stream, const Pixel *row) {
+    const ResizePlan *plan = stream->plan;
+    int srcY;
+
+    if (stream->nextSrcY >= plan->srcHeight) return -1;
+    srcY = stream->nextSrcY++;
+
+    /* Semua baris tujuan yang bisa selesai sudah dikirim saat push
+     * sebelumnya, jadi hanya baris tujuan berikutnya yang relevan */
+    if (stream->nextDstY < plan->dstHeight &&
+        (plan->yIndex0[stream->nextDstY] == srcY || plan->yIndex1[stream->nextDstY] == srcY)) {
+        storeCachedRow(&stream->cache, plan, stream->kernels, srcY, (const float*)row);
+    }
+
+    while (stream->nextDstY < plan->dstHeight && plan->yIndex1[stream->nextDstY] <= srcY) {
+        int y = stream->nextDstY++;
+        const float *top = (stream->cache.srcY[0] == plan->yIndex0[y])
+                         ? stream->cache.rows[0] : stream->cache.rows[1];
+        const float *bot = (stream->cache.srcY[0] == plan->yIndex1[y])
+                         ? stream->cache.rows[0] : stream->cache.rows[1];
+
+        if (top == bot)
+            memcpy(stream->outRow, top, 3 * plan->dstWidth * sizeof(float));
+        else
+            stream->kernels->vertical(top, bot, plan->yFrac[y], (float*)stream->outRow,
+                                      3 * plan->dstWidth);
+        stream->sink(stream->userData, y, stream->outRow);
+    }
+
+    return 0;
+}
+
+/* 1 jika semua baris tujuan sudah dikirim ke sink */
+int resizeStreamDone(const ResizeStream *stream) {
+    return stream->nextDstY == stream->plan->dstHeight;
+}
+
+/* Versi pull: baca semua baris sumber dari source callback.
+ * Return 0 sukses, -1 jika alokasi gagal atau source membatalkan. */
+int resizeStreamRun(int srcWidth, int srcHeight, int dstWidth, int dstHeight,
+                    ScanlineSource source, void *sourceData,
+                    ScanlineSink sink, void *sinkData) {
+    ResizeStream *stream;
+    Pixel *row;
+    int y, status = 0;
+
+    stream = createResizeStream(srcWidth, srcHeight, dstWidth, dstHeight, sink, sinkData);
+    row = (Pixel*)malloc((size_t)srcWidth * sizeof(Pixel));
+    if (!stream || !row) {
+        freeResizeStream(stream);
+        free(row);
+        return -1;
+    }
+
+    for (y = 0; y < srcHeight && !resizeStreamDone(stream); y++) {
+        if (source(sourceData, y, row) != 0) {
+            status = -1;
+            break;
+        }
+        resizeStreamPush(stream, row);
+    }
+
+    free(row);
+    freeResizeStream(stream);
+    return status;
+}
+
+/* ============================================================================
+ * RESIZE 8-BIT (Fixed-point Q14)
+ * ============================================================================
+ * Horizontal: mid = (a * (16384 - wx) + b * wx + 64) >> 7      -> Q7 (int16)
+ * Vertikal:   out = (top * (16384 - wy) + bot * wy + 2^20) >> 21
+ * Semua integer 32-bit, tanpa float: mid <= 255 * 128, jumlah vertikal
+ * <= 255 * 128 * 16384 < 2^31. Selisih terhadap path float <= 1 level.
+ */
+
+#define MID_SHIFT   7
+#define MID_ROUND   (1 << (FIXED_SHIFT - MID_SHIFT - 1))
+#define OUT_SHIFT   (FIXED_SHIFT + MID_SHIFT)
+#define OUT_ROUND   (1 << (OUT_SHIFT - 1))
+
+/* CH konstan per varian supaya loop channel di-unroll compiler */
+#define DEFINE_HORIZONTAL_U8(CH)                                              \
+static void horizontalU8_##CH(const uint8_t *srcRow, const ResizePlan *plan,  \
+                              int16_t *out) {                                  \
+    int x, c;                                                                  \
+    for (x = 0; x < plan->dstWidth; x++) {                                     \
+        const uint8_t *a = srcRow + CH * plan->xIndex0[x];                     \
+        const uint8_t *b = srcRow + CH * plan->xIndex1[x];                     \
+        int wx = plan->xWeightQ14[x];                                          \
+        for (c = 0; c < CH; c++) {                                             \
+            out[CH * x + c] = (int16_t)((a[c] * (FIXED_ONE - wx) + b[c] * wx   \
+                                         + MID_ROUND) >> (FIXED_SHIFT - MID_SHIFT)); \
+        }                                                                      \
+    }                                                                          \
+}
+
+DEFINE_HORIZONTAL_U8(1)
+DEFINE_HORIZONTAL_U8(3)
+DEFINE_HORIZONTAL_U8(4)
+
+/* Upsample 2x/4x: bobot Q14 tetap j * 16384 / n, sama dengan xWeightQ14 plan.
+ * Dipanggil dengan ch dan n literal supaya setelah inline loop di-unroll */
+static inline void horizontalU8Upsample(const uint8_t *srcRow, int srcWidth, int ch,
+                                        int n, int16_t *out) {
+    const uint8_t *a = srcRow + ch * (srcWidth - 1);
+    int k, j, c;
+
+    for (k = 0; k < srcWidth - 1; k++) {
+        const uint8_t *p = srcRow + ch * k;
+
+        for (j = 0; j < n; j++) {
+            int wx = j * (FIXED_ONE / n);
+
+            for (c = 0; c < ch; c++) {
+                out[ch * (n * k + j) + c] = (int16_t)((p[c] * (FIXED_ONE - wx) + p[c + ch] * wx
+                                                       + MID_ROUND) >> (FIXED_SHIFT - MID_SHIFT));
+            }
+        }
+    }
+    for (j = 0; j < n * ch; j++) {
+        out[ch * n * (srcWidth - 1) + j] = (int16_t)(a[j % ch] << MID_SHIFT);
+    }
+}
+
+static void horizontalU8(const uint8_t *srcRow, const ResizePlan *plan,
+                         int channels, int16_t *out) {
+    if (plan->ratio == RATIO_UPSAMPLE) {
+        int w = plan->srcWidth;
+
+        switch (channels * 8 + plan->ratioFactor) {
+            case 1 * 8 + 2: horizontalU8Upsample(srcRow, w, 1, 2, out); break;
+            case 1 * 8 + 4: horizontalU8Upsample(srcRow, w, 1, 4, out); break;
+            case 3 * 8 + 2: horizontalU8Upsample(srcRow, w, 3, 2, out); break;
+            case 3 * 8 + 4: horizontalU8Upsample(srcRow, w, 3, 4, out); break;
+            case 4 * 8 + 2: horizontalU8Upsample(srcRow, w, 4, 2, out); break;
+            default:        horizontalU8Upsample(srcRow, w, 4, 4, out); break;
+        }
+        return;
+    }
+    switch (channels) {
+        case 1: horizontalU8_1(srcRow, plan, out); break;
+        case 3: horizontalU8_3(srcRow, plan, out); break;
+        default: horizontalU8_4(srcRow, plan, out); break;
+    }
+}
+
+static void verticalU8(const int16_t *top, const int16_t *bot, int wy,
+                       uint8_t *out, int count) {
+    int j;
+
+    for (j = 0; j < count; j++) {
+        out[j] = (uint8_t)((top[j] * (FIXED_ONE - wy) + bot[j] * wy + OUT_ROUND) >> OUT_SHIFT);
+    }
+}
+
+/* Row cache 8-bit (intermediate Q7 int16), kebijakan slot sama dengan RowCache */
+typedef struct {
+    int16_t *rows[2];
+    int srcY[2];
+} RowCacheU8;
+
+static int initRowCacheU8(RowCacheU8 *cache, int lanes) {
+    cache->rows[0] = (int16_t*)malloc(2 * (size_t)lanes * sizeof(int16_t));
+    cache->rows[1] = cache->rows[0] ? cache->rows[0] + lanes : NULL;
+    cache->srcY[0] = -1;
+    cache->srcY[1] = -1;
+    return cache->rows[0] ? 0 : -1;
+}
+
+static const int16_t* getCachedRowU8(RowCacheU8 *cache, const ImageU8 *source,
+                                     const ResizePlan *plan, int srcY) {
+    int slot;
+
+    if (cache->srcY[0] == srcY) return cache->rows[0];
+    if (cache->srcY[1] == srcY) return cache->rows[1];
+
+    slot = (cache->srcY[0] < cache->srcY[1]) ? 0 : 1;
+    horizontalU8(source->data + (size_t)srcY * source->stride, plan, source->channels,
+                 cache->rows[slot]);
+    cache->srcY[slot] = srcY;
+    return cache->rows[slot];
+}
+
+static void resizeRowU8(const ImageU8 *source, const ResizePlan *plan,
+                        RowCacheU8 *cache, uint8_t *out, int y) {
+    const int16_t *top = getCachedRowU8(cache, source, plan, plan->yIndex0[y]);
+    const int16_t *bot = (plan->yIndex1[y] == plan->yIndex0[y]) ? top
+                       : getCachedRowU8(cache, source, plan, plan->yIndex1[y]);
+
+    verticalU8(top, bot, plan->yWeightQ14[y], out, source->channels * plan->dstWidth);
+}
+
+/* Rasio 1/n: bobot Q14 semuanya 0 sehingga hasil path umum = pixel sumber,
+ * cukup salin pixel (n*x, n*y); ch literal per pemanggil */
+static inline void decimateRowU8(const uint8_t *src, int width, int ch, int n, uint8_t *out) {
+    int x, c;
+
+    for (x = 0; x < width; x++) {
+        for (c = 0; c < ch; c++)
+            out[ch * x + c] = src[ch * n * x + c];
+    }
+}
+
+static int decimateRowsU8(const ImageU8 *source, ImageU8 *dest, const ResizePlan *plan,
+                          int numThreads) {
+    int n = plan->ratioFactor;
+    int ch = source->channels;
+    int y;
+    INSTR_REGION_BEGIN(region);
+
+#ifdef USE_OPENMP
+    #pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+#endif
+    {
+        INSTR_SPAN_BEGIN(span);
+
+#ifdef USE_OPENMP
+        #pragma omp for schedule(static) nowait
+#endif
+        for (y = 0; y < plan->dstHeight; y++) {
+            const uint8_t *src = source->data + (size_t)y * n * source->stride;
+            uint8_t *out = dest->data + (size_t)y * dest->stride;
+
+            switch (n == 1 ? 0 : ch) {
+                case 0:  memcpy(out, src, (size_t)plan->dstWidth * ch); break;
+                case 1:  decimateRowU8(src, plan->dstWidth, 1, n, out); break;
+                case 3:  decimateRowU8(src, plan->dstWidth, 3, n, out); break;
+                default: decimateRowU8(src, plan->dstWidth, 4, n, out); break;
+            }
+            INSTR_SPAN_PIXELS(span, plan->dstWidth);
+        }
+
+        INSTR_SPAN_END(region, span);
+    }
+    INSTR_REGION_END(region);
+    (void)numThreads;
+    return 0;
+}
+
+/* Tulis semua baris tujuan 8-bit ke dest; numThreads <= 1 = serial */
+static int resizeRowsU8(const ImageU8 *source, ImageU8 *dest, const ResizePlan *plan,
+                        int numThreads) {
+    int lanes = source->channels * plan->dstWidth;
+    int failed = 0;
+
+    if (plan->ratio == RATIO_DECIMATE)
+        return decimateRowsU8(source, dest, plan, numThreads);
+
+    INSTR_REGION_BEGIN(region);
+#ifdef USE_OPENMP
+    if (numThreads > 1) {
+        #pragma omp parallel num_threads(numThreads)
+        {
+            RowCacheU8 cache;
+            int ok = initRowCacheU8(&cache, lanes) == 0;
+            int y;
+            INSTR_SPAN_BEGIN(span);
+
+            if (!ok) {
+                #pragma omp atomic write
+                failed = 1;
+            }
+
+            #pragma omp for schedule(static) nowait
+            for (y = 0; y < plan->dstHeight; y++) {
+                if (ok) {
+                    resizeRowU8(source, plan, &cache, dest->data + (size_t)y * dest->stride, y);
+                    INSTR_SPAN_PIXELS(span, plan->dstWidth);
+                }
+            }
+
+            INSTR_SPAN_END(region, span);
+            free(cache.rows[0]);
+        }
+        INSTR_REGION_END(region);
+        return failed ? -1 : 0;
+    }
+#endif
+    {
+        RowCacheU8 cache;
+        int y;
+        INSTR_SPAN_BEGIN(span);
+
+        (void)numThreads;
+        if (initRowCacheU8(&cache, lanes) != 0) return -1;
+
+        for (y = 0; y < plan->dstHeight; y++) {
+            resizeRowU8(source, plan, &cache, dest->data + (size_t)y * dest->stride, y);
+            INSTR_SPAN_PIXELS(span, plan->dstWidth);
+        }
+
+        free(cache.rows[0]);
+        INSTR_SPAN_END(region, span);
+    }
+    INSTR_REGION_END(region);
+    return failed ? -1 : 0;
+}
+
+/* Versi 8-bit dari resizeIntoPlan; channels source dan dest harus sama */
+int resizeU8Into(const ImageU8 *source, ImageU8 *dest, const ResizePlan *plan, int numThreads) {
+    if (!source || !dest || !u8ChannelsSupported(source->channels) ||
+        source->channels != dest->channels ||
+        dest->stride < dest->width * dest->channels ||
+        !planMatches(plan, source->width, source->height, dest->width, dest->height))
+        return -1;
+
+    return resizeRowsU8(source, dest, plan, numThreads);
+}
+
+static ImageU8* resizeU8Alloc(const ImageU8 *source, const ResizePlan *plan, int numThreads) {
+    ImageU8 *dest;
+    INSTR_PHASE_BEGIN(allocStart);
+
+    if (!plan || !u8ChannelsSupported(source->channels) ||
+        source->width != plan->srcWidth || source->height != plan->srcHeight)
+        return NULL;
+
+    dest = createImageU8(plan->dstWidth, plan->dstHeight, source->channels);
+    if (!dest) return NULL;
+    INSTR_PHASE_END(allocStart, PHASE_ALLOC);
+
+    if (resizeRowsU8(source, dest, plan, numThreads) != 0) {
+        freeImageU8(dest);
+        return NULL;
+    }
+    return dest;
+}
+
+ImageU8* resizeU8Serial(const ImageU8 *source, const ResizePlan *plan) {
+    return resizeU8Alloc(source, plan, 1);
+}
+
+#ifdef USE_OPENMP
+ImageU8* resizeU8OpenMP(const ImageU8 *source, const ResizePlan *plan, int numThreads) {
+    return resizeU8Alloc(source, plan, numThreads);
+}
+#endif
+
+/* ============================================================================
+ * RESIZE -> TENSOR TERNORMALISASI (Preprocessing ML)
+ * ============================================================================
+ * Satu pass: baris hasil resize (tetap di L1, per thread) langsung ditulis
+ * ke tensor float NCHW (planar) atau NHWC dengan
+ *     out = (in * scale - mean[c]) / std[c]
+ * dan opsi urutan channel BGR. Tidak ada image antara, tidak ada pass
+ * terpisah untuk normalisasi / swap channel / de-interleave.
+ */
+
+typedef enum { TENSOR_NCHW, TENSOR_NHWC } TensorLayout;
+
+typedef struct {
+    TensorLayout layout;
+    int swapRB;         /* 1 = tulis channel urutan BGR */
+    float scale;        /* skala input dulu, mis. 1/255 untuk sumber 8-bit */
+    float mean[3];      /* per channel output (setelah swap) */
+    float std[3];
+} TensorFormat;
+
+/* out = in * mul[c] + add[c], input channel srcChannel[c] */
+typedef struct {
+    float mul[3];
+    float add[3];
+    int srcChannel[3];
+    int channels;       /* channel tensor: 1 (gray) atau 3 */
+} TensorStage;
+
+static int prepareTensorStage(const TensorFormat *fmt, int inChannels, TensorStage *st) {
+    int c;
+
+    st->channels = (inChannels == 1) ? 1 : 3;
+    for (c = 0; c < st->channels; c++) {
+        if (fmt->std[c] == 0.0f) return -1;
+        st->mul[c] = fmt->scale / fmt->std[c];
+        st->add[c] = -fmt->mean[c] / fmt->std[c];
+        st->srcChannel[c] = (fmt->swapRB && st->channels == 3) ? 2 - c : c;
+    }
+    return 0;
+}
+
+/* Tulis baris y (width pixel, stride input lanes per pixel) ke tensor */
+#define DEFINE_TENSOR_STORE(NAME, TYPE)                                        \
+static void NAME(const TYPE *row, int lanes, int width, int height,            \
+                 const TensorStage *st, TensorLayout layout, float *tensor, int y) { \
+    int x, c;                                                                  \
+    if (layout == TENSOR_NCHW) {                                               \
+        for (c = 0; c < st->channels; c++) {                                   \
+            float *plane = tensor + ((size_t)c * height + y) * width;          \
+            const TYPE *in = row + st->srcChannel[c];                          \
+            float mul = st->mul[c], add = st->add[c];                          \
+            for (x = 0; x < width; x++) plane[x] = in[(size_t)x * lanes] * mul + add; \
+        }                                                                      \
+    } else {                                                                   \
+        float *out = tensor + (size_t)y * width * st->channels;                \
+        for (x = 0; x < width; x++) {                                          \
+            for (c = 0; c < st->channels; c++) {                               \
+                out[x * st->channels + c] = row[(size_t)x * lanes + st->srcChannel[c]] \
+                                            * st->mul[c] + st->add[c];         \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+}
+
+DEFINE_TENSOR_STORE(tensorStoreRowF32, float)
+DEFINE_TENSOR_STORE(tensorStoreRowU8, uint8_t)
+
+/* Isi salah satu: source (float) atau sourceU8 */
+static int resizeRowsToTensor(const Image *source, const ImageU8 *sourceU8, float *tensor,
+                              const ResizePlan *plan, const TensorFormat *fmt, int numThreads) {
+    int lanes = source ? 3 : sourceU8->channels;
+    size_t cacheBytes = source ? 2 * (size_t)lanes * plan->dstWidth * sizeof(float)
+                               : 2 * (size_t)lanes * plan->dstWidth * sizeof(int16_t);
+    size_t rowBytes = source ? (size_t)lanes * plan->dstWidth * sizeof(float)
+                             : (size_t)lanes * plan->dstWidth;
+    const ResizeKernels *k = getResizeKernels();
+    TensorStage stage;
+    int failed = 0;
+
+    if (!tensor || !fmt || prepareTensorStage(fmt, lanes, &stage) != 0) return -1;
+
+#ifdef USE_OPENMP
+    #pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+#endif
+    {
+        /* Scratch per thread: 2 baris cache + 1 baris hasil resize */
+        char *scratch = (char*)malloc(cacheBytes + rowBytes);
+        RowCache cache;
+        RowCacheU8 cacheU8;
+        int y;
+
+        if (!scratch) {
+#ifdef USE_OPENMP
+            #pragma omp atomic write
+#endif
+            failed = 1;
+        } else {
+            cache.rows[0] = (float*)scratch;
+            cache.rows[1] = cache.rows[0] + (size_t)lanes * plan->dstWidth;
+            cacheU8.rows[0] = (int16_t*)scratch;
+            cacheU8.rows[1] = cacheU8.rows[0] + (size_t)lanes * plan->dstWidth;
+            cache.srcY[0] = cache.srcY[1] = -1;
+            cacheU8.srcY[0] = cacheU8.srcY[1] = -1;
+        }
+
+#ifdef USE_OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (y = 0; y < plan->dstHeight; y++) {
+            if (!scratch) continue;
+            if (source) {
+                float *row = (float*)(scratch + cacheBytes);
+                resizeRowCached(source, plan, k, &cache, (Pixel*)row, y);
+                tensorStoreRowF32(row, 3, plan->dstWidth, plan->dstHeight, &stage,
+                                  fmt->layout, tensor, y);
+            } else {
+                uint8_t *row = (uint8_t*)(scratch + cacheBytes);
+                resizeRowU8(sourceU8, plan, &cacheU8, row, y);
+                tensorStoreRowU8(row, lanes, plan->dstWidth, plan->dstHeight, &stage,
+                                 fmt->layout, tensor, y);
+            }
+        }
+
+        free(scratch);
+    }
+    (void)numThreads;
+    return failed ? -1 : 0;
+}
+
+/* Resize source ke tensor float [C][H][W] atau [H][W][C] (H, W = ukuran
+ * tujuan plan, C = 3). Return 0 sukses, -1 gagal. */
+int resizeToTensor(const Image *source, float *tensor, const ResizePlan *plan,
+                   const TensorFormat *fmt, int numThreads) {
+    if (!source || !planMatches(plan, source->width, source->height,
+                                plan ? plan->dstWidth : 0, plan ? plan->dstHeight : 0))
+        return -1;
+    return resizeRowsToTensor(source, NULL, tensor, plan, fmt, numThreads);
+}
+
+/* Versi input 8-bit: C = 1 untuk gray, 3 untuk RGB/RGBA (alpha dibuang) */
+int resizeU8ToTensor(const ImageU8 *source, float *tensor, const ResizePlan *plan,
+                     const TensorFormat *fmt, int numThreads) {
+    if (!source || !u8ChannelsSupported(source->channels) || !planMatches(plan, source->width, source->height,
+                                plan ? plan->dstWidth : 0, plan ? plan->dstHeight : 0))
+        return -1;
+    return resizeRowsToTensor(NULL, source, tensor, plan, fmt, numThreads);
+}
+
+/* ============================================================================
+ * RASTER GENERIK: 1-4 CHANNEL x u8/u16/f16/f32
+ * ============================================================================
+ * RasterView mendeskripsikan buffer apa pun (tipe elemen, channel, stride
+ * byte). Kernel horizontal dibangkitkan makro per (tipe, channel) sehingga
+ * loop channel konstan dan di-unroll/vektorisasi compiler; pass vertikal +
+ * konversi ke tipe tujuan dibangkitkan per tipe. Intermediate float.
+ * resizeRaster memilih kernel dari tabel; u8 1/3/4 channel diteruskan ke
+ * path fixed-point Q14 yang sudah ada. Half float dikonversi software.
+ */
+
+typedef enum { ELEM_U8, ELEM_U16, ELEM_F16, ELEM_F32 } ElementType;
+
+typedef struct {
+    void *data;
+    int width, height;
+    int channels;       /* 1..4 */
+    ElementType type;
+    size_t stride;      /* byte per baris */
+} RasterView;
+
+RasterView rasterView(void *data, int width, int height, int channels,
+                      ElementType type, size_t stride) {
+    RasterView view;
+
+    view.data = data;
+    view.width = width;
+    view.height = height;
+    view.channels = channels;
+    view.type = type;
+    view.stride = stride;
+    return view;
+}
+
+RasterView rasterFromImage(const Image *img) {
+    return rasterView(img->data, img->width, img->height, 3, ELEM_F32,
+                      (size_t)img->stride * sizeof(Pixel));
+}
+
+RasterView rasterFromImageU8(const ImageU8 *img) {
+    return rasterView(img->data, img->width, img->height, img->channels, ELEM_U8,
+                      (size_t)img->stride);
+}
+
+/* IEEE 754 binary16 <-> binary32, round-to-nearest-even, inf/NaN dijaga */
+float halfToFloat(uint16_t h) {
+    uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    uint32_t exp = (h >> 10) & 0x1f;
+    uint32_t mant = h & 0x3ff;
+    uint32_t bits;
+    float f;
+
+    if (exp == 0) {
+        /* Nol / subnormal: mant * 2^-24, eksak di float */
+        f = (float)mant * (1.0f / 16777216.0f);
+        return sign ? -f : f;
+    }
+    if (exp == 31)
+        bits = sign | 0x7f800000 | (mant << 13);
+    else
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+uint16_t floatToHalf(float f) {
+    uint32_t x, absx, sign, h, rem;
+
+    memcpy(&x, &f, sizeof(x));
+    sign = (x >> 16) & 0x8000;
+    absx = x & 0x7fffffff;
+
+    if (absx >= 0x7f800000)                 /* inf / NaN */
+        return (uint16_t)(sign | 0x7c00 | (absx > 0x7f800000 ? 0x200 : 0));
+    if (absx >= 0x477ff000)                 /* >= 65520 dibulatkan ke inf */
+        return (uint16_t)(sign | 0x7c00);
+
+    if (absx < 0x38800000) {                /* < 2^-14: subnormal half */
+        uint32_t m, shift, mid;
+
+        if (absx <= 0x33000000) return (uint16_t)sign;    /* <= 2^-25 -> 0 */
+        m = (absx & 0x7fffff) | 0x800000;
+        shift = 126 - (absx >> 23);
+        h = m >> shift;
+        rem = m & ((1u << shift) - 1);
+        mid = 1u << (shift - 1);
+        if (rem > mid || (rem == mid && (h & 1))) h++;
+        return (uint16_t)(sign | h);
+    }
+
+    h = (absx - 0x38000000) >> 13;          /* rebias eksponen 127 -> 15 */
+    rem = absx & 0x1fff;
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1))) h++;
+    return (uint16_t)(sign | h);
+}
+
+static uint8_t storeSatU8(float v) {
+    return (v <= 0.0f) ? 0 : (v >= 255.0f) ? 255 : (uint8_t)(v + 0.5f);
+}
+
+static uint16_t storeSatU16(float v) {
+    return (v <= 0.0f) ? 0 : (v >= 65535.0f) ? 65535 : (uint16_t)(v + 0.5f);
+}
+
+#define LOAD_INT(v)     ((float)(v))
+#define LOAD_HALF(v)    halfToFloat(v)
+#define LOAD_FLOAT(v)   (v)
+#define STORE_FLOAT(v)  (v)
+
+typedef void (*RasterHorizontal)(const void *srcRow, const ResizePlan *plan, float *out);
+typedef void (*RasterStore)(const float *top, const float *bot, float fy,
+                            void *dstRow, int count);
+
+/* ATTR boleh kosong; diisi atribut target untuk varian ISA khusus */
+#define DEFINE_RASTER_HORIZONTAL(NAME, TYPE, LOAD, CH, ATTR)                   \
+static ATTR void rasterHorizontal_##NAME##_##CH(const void *srcRow, const ResizePlan *plan, \
+                                                float *out) {                  \
+    const TYPE *row = (const TYPE*)srcRow;                                     \
+    int x, c;                                                                  \
+    for (x = 0; x < plan->dstWidth; x++) {                                     \
+        const TYPE *a = row + CH * plan->xIndex0[x];                           \
+        const TYPE *b = row + CH * plan->xIndex1[x];                           \
+        float fx = plan->xFrac[x];                                             \
+        for (c = 0; c < CH; c++) {                                             \
+            float va = LOAD(a[c]);                                             \
+            out[CH * x + c] = va + fx * (LOAD(b[c]) - va);                     \
+        }                                                                      \
+    }                                                                          \
+}
+
+/* Vertikal + konversi: lerp dua baris float lalu simpan sebagai TYPE */
+#define DEFINE_RASTER_TYPE(NAME, TYPE, LOAD, STORE)                            \
+DEFINE_RASTER_HORIZONTAL(NAME, TYPE, LOAD, 1, )                                \
+DEFINE_RASTER_HORIZONTAL(NAME, TYPE, LOAD, 2, )                                \
+DEFINE_RASTER_HORIZONTAL(NAME, TYPE, LOAD, 3, )                                \
+DEFINE_RASTER_HORIZONTAL(NAME, TYPE, LOAD, 4, )                                \
+static void rasterStore_##NAME(const float *top, const float *bot, float fy,  \
+                               void *dstRow, int count) {                     \
+    TYPE *out = (TYPE*)dstRow;                                                 \
+    int j;                                                                     \
+    for (j = 0; j < count; j++) {                                              \
+        out[j] = STORE(top[j] + fy * (bot[j] - top[j]));                       \
+    }                                                                          \
+}
+
+DEFINE_RASTER_TYPE(u8,  uint8_t,  LOAD_INT,   storeSatU8)
+DEFINE_RASTER_TYPE(u16, uint16_t, LOAD_INT,   storeSatU16)
+DEFINE_RASTER_TYPE(f16, uint16_t, LOAD_HALF,  floatToHalf)
+DEFINE_RASTER_TYPE(f32, float,    LOAD_FLOAT, STORE_FLOAT)
+
+typedef struct {
+    RasterHorizontal horizontal[4];     /* index channels - 1 */
+    RasterStore store;
+    size_t elemSize;
+} RasterKernels;
+
+/* Urutan sama dengan ElementType */
+static const RasterKernels rasterKernelTable[] = {
+    { { rasterHorizontal_u8_1, rasterHorizontal_u8_2, rasterHorizontal_u8_3, rasterHorizontal_u8_4 },
+      rasterStore_u8, sizeof(uint8_t) },
+    { { rasterHorizontal_u16_1, rasterHorizontal_u16_2, rasterHorizontal_u16_3, rasterHorizontal_u16_4 },
+      rasterStore_u16, sizeof(uint16_t) },
+    { { rasterHorizontal_f16_1, rasterHorizontal_f16_2, rasterHorizontal_f16_3, rasterHorizontal_f16_4 },
+      rasterStore_f16, sizeof(uint16_t) },
+    { { rasterHorizontal_f32_1, rasterHorizontal_f32_2, rasterHorizontal_f32_3, rasterHorizontal_f32_4 },
+      rasterStore_f32, sizeof(float) },
+};
+
+#ifdef HAVE_X86_KERNELS
+/* F16C: konversi half hardware. Pembulatan sama dengan floatToHalf dan
+ * urutan aritmetika sama dengan versi scalar, jadi hasil bit-identik. */
+#define F16C_TARGET     __attribute__((target("avx,f16c")))
+#define LOAD_HALF_F16C(v) _cvtsh_ss(v)
+
+DEFINE_RASTER_HORIZONTAL(f16c, uint16_t, LOAD_HALF_F16C, 1, F16C_TARGET)
+DEFINE_RASTER_HORIZONTAL(f16c, uint16_t, LOAD_HALF_F16C, 2, F16C_TARGET)
+DEFINE_RASTER_HORIZONTAL(f16c, uint16_t, LOAD_HALF_F16C, 3, F16C_TARGET)
+
+/* RGBA half = 64 bit, satu pixel per konversi 4 lane */
+F16C_TARGET
+static void rasterHorizontal_f16c_4(const void *srcRow, const ResizePlan *plan, float *out) {
+    const uint16_t *row = (const uint16_t*)srcRow;
+    int x;
+
+    for (x = 0; x < plan->dstWidth; x++) {
+        __m128 a = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(row + 4 * plan->xIndex0[x])));
+        __m128 b = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i*)(row + 4 * plan->xIndex1[x])));
+        __m128 fx = _mm_set1_ps(plan->xFrac[x]);
+        _mm_storeu_ps(out + 4 * x, _mm_add_ps(a, _mm_mul_ps(fx, _mm_sub_ps(b, a))));
+    }
+}
+
+F16C_TARGET
+static void rasterStore_f16c(const float *top, const float *bot, float fy,
+                             void *dstRow, int count) {
+    uint16_t *out = (uint16_t*)dstRow;
+    __m256 w = _mm256_set1_ps(fy);
+    int j = 0;
+
+    for (; j + 8 <= count; j += 8) {
+        __m256 t = _mm256_loadu_ps(top + j);
+        __m256 b = _mm256_loadu_ps(bot + j);
+        __m256 v = _mm256_add_ps(t, _mm256_mul_ps(w, _mm256_sub_ps(b, t)));
+        _mm_storeu_si128((__m128i*)(out + j), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+    }
+    for (; j < count; j++) {
+        out[j] = _cvtss_sh(top[j] + fy * (bot[j] - top[j]), _MM_FROUND_TO_NEAREST_INT);
+    }
+}
+
+static const RasterKernels rasterKernelsF16c = {
+    { rasterHorizontal_f16c_1, rasterHorizontal_f16c_2, rasterHorizontal_f16c_3, rasterHorizontal_f16c_4 },
+    rasterStore_f16c, sizeof(uint16_t)
+};
+#endif
+
+static const float* rasterCachedRow(RowCache *cache, const RasterView *source,
+                                    const ResizePlan *plan, RasterHorizontal horizontal, int srcY) {
+    int slot;
+
+    if (cache->srcY[0] == srcY) return cache->rows[0];
+    if (cache->srcY[1] == srcY) return cache->rows[1];
+
+    slot = (cache->srcY[0] < cache->srcY[1]) ? 0 : 1;
+    horizontal((const char*)source->data + (size_t)srcY * source->stride, plan, cache->rows[slot]);
+    cache->srcY[slot] = srcY;
+    return cache->rows[slot];
+}
+
+static int rasterValid(const RasterView *r) {
+    return r && r->data && r->width > 0 && r->height > 0 &&
+           r->channels >= 1 && r->channels <= 4 &&
+           r->type >= ELEM_U8 && r->type <= ELEM_F32 &&
+           r->stride >= (size_t)r->width * r->channels * rasterKernelTable[r->type].elemSize;
+}
+
+/* Satu entry point untuk semua tipe/channel; source dan dest harus sama
+ * tipe dan jumlah channel. Return 0 sukses, -1 gagal. */
+int resizeRaster(const RasterView *source, RasterView *dest, const ResizePlan *plan,
+                 int numThreads) {
+    const RasterKernels *k;
+    RasterHorizontal horizontal;
+    int lanes, failed = 0;
+
+    if (!rasterValid(source) || !rasterValid(dest) || source->type != dest->type ||
+        source->channels != dest->channels ||
+        !planMatches(plan, source->width, source->height, dest->width, dest->height))
+        return -1;
+
+    if (source->type == ELEM_U8 && source->channels != 2 &&
+        source->stride <= INT32_MAX && dest->stride <= INT32_MAX) {
+        ImageU8 src = imageU8View((uint8_t*)source->data, source->width, source->height,
+                                  source->channels, (int)source->stride);
+        ImageU8 dst = imageU8View((uint8_t*)dest->data, dest->width, dest->height,
+                                  dest->channels, (int)dest->stride);
+        return resizeU8Into(&src, &dst, plan, numThreads);
+    }
+
+    k = &rasterKernelTable[source->type];
+#ifdef HAVE_X86_KERNELS
+    if (source->type == ELEM_F16 && __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c"))
+        k = &rasterKernelsF16c;
+#endif
+    horizontal = k->horizontal[source->channels - 1];
+    lanes = source->channels * plan->dstWidth;
+
+#ifdef USE_OPENMP
+    #pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+#endif
+    {
+        RowCache cache;
+        int ok = initRowCache(&cache, lanes) == 0;
+        int y;
+
+        if (!ok) {
+#ifdef USE_OPENMP
+            #pragma omp atomic write
+#endif
+            failed = 1;
+        }
+
+#ifdef USE_OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (y = 0; y < plan->dstHeight; y++) {
+            const float *top, *bot;
+
+            if (!ok) continue;
+            top = rasterCachedRow(&cache, source, plan, horizontal, plan->yIndex0[y]);
+            bot = (plan->yIndex1[y] == plan->yIndex0[y]) ? top
+                : rasterCachedRow(&cache, source, plan, horizontal, plan->yIndex1[y]);
+            k->store(top, bot, plan->yFrac[y], (char*)dest->data + (size_t)y * dest->stride, lanes);
+        }
+
+        freeRowCache(&cache);
+    }
+    (void)numThreads;
+    return failed ? -1 : 0;
+}
+
+/* ============================================================================
+ * BATCH RESIZE (Paralel antar image)
+ * ============================================================================
+ * Job kecil (thumbnail) dijalankan utuh oleh satu thread dengan schedule
+ * dynamic, jadi hanya ada satu fork/join untuk seluruh batch. Hanya job
+ * besar (>= BATCH_SPLIT_PIXELS pixel tujuan) yang dipecah per baris ke
+ * semua thread. Plan dipakai ulang selama geometri job berurutan sama.
+ */
+
+#define BATCH_SPLIT_PIXELS (512 * 512)
+
+/* Isi tepat satu pasangan: source/dest (float) atau sourceU8/destU8 */
+typedef struct {
+    const Image *source;
+    Image *dest;
+    const ImageU8 *sourceU8;
+    ImageU8 *destU8;
+    int status;         /* output: 0 sukses, -1 gagal */
+} ResizeJob;
+
+static void jobGeometry(const ResizeJob *job, int *srcW, int *srcH, int *dstW, int *dstH) {
+    if (job->source && job->dest) {
+        *srcW = job->source->width;  *srcH = job->source->height;
+        *dstW = job->dest->width;    *dstH = job->dest->height;
+    } else if (job->sourceU8 && job->destU8) {
+        *srcW = job->sourceU8->width; *srcH = job->sourceU8->height;
+        *dstW = job->destU8->width;   *dstH = job->destU8->height;
+    } else {
+        *srcW = *srcH = *dstW = *dstH = 0;
+    }
+}
+
+/* Jalankan satu job; *plan = plan terakhir (dari plan cache), diganti
+ * jika geometri beda */
+static int runResizeJob(ResizeJob *job, const ResizePlan **plan, int numThreads) {
+    int srcW, srcH, dstW, dstH;
+
+    jobGeometry(job, &srcW, &srcH, &dstW, &dstH);
+    if (!planMatches(*plan, srcW, srcH, dstW, dstH)) {
+        releaseResizePlan(*plan);
+        *plan = acquireResizePlan(srcW, srcH, dstW, dstH);
+        if (!*plan) return -1;
+    }
+
+    if (job->source)
+        return resizeIntoPlan(job->source, job->dest, *plan, numThreads);
+    return resizeU8Into(job->sourceU8, job->destU8, *plan, numThreads);
+}
+
+/* Return jumlah job yang gagal (status per job di jobs[i].status) */
+int resizeBatch(ResizeJob *jobs, int count, int numThreads) {
+    const ResizePlan *plan = NULL;
+    int failed = 0;
+    int i;
+
+    /* Job besar: satu per satu, paralel di dalam image */
+    for (i = 0; i < count; i++) {
+        int srcW, srcH, dstW, dstH;
+
+        jobGeometry(&jobs[i], &srcW, &srcH, &dstW, &dstH);
+        if ((long)dstW * dstH < BATCH_SPLIT_PIXELS) continue;
+
+        jobs[i].status = runResizeJob(&jobs[i], &plan, numThreads);
+        if (jobs[i].status != 0) failed++;
+    }
+    releaseResizePlan(plan);
+
+    /* Job kecil: dibagi antar thread, satu job utuh per thread */
+#ifdef USE_OPENMP
+    #pragma omp parallel num_threads(numThreads > 1 ? numThreads : 1) reduction(+:failed)
+#endif
+    {
+        const ResizePlan *threadPlan = NULL;
+        int j;
+
+#ifdef USE_OPENMP
+        #pragma omp for schedule(dynamic, 1)
+#endif
+        for (j = 0; j < count; j++) {
+            int srcW, srcH, dstW, dstH;
+
+            jobGeometry(&jobs[j], &srcW, &srcH, &dstW, &dstH);
+            if ((long)dstW * dstH >= BATCH_SPLIT_PIXELS) continue;
+
+            jobs[j].status = runResizeJob(&jobs[j], &threadPlan, 1);
+            if (jobs[j].status != 0) failed++;
+        }
+
+        releaseResizePlan(threadPlan);
+    }
+
+    return failed;
+}
+
+/* ============================================================================
+ * ROI: CROP + RESIZE TANPA SALINAN
+ * ============================================================================
+ * Region = view ke data parent dengan stride parent, jadi crop tidak
+ * mengalokasi/menyalin apa pun dan resize hanya membaca pixel di dalam ROI.
+ * Versi batch memetakan setiap ROI ke ResizeJob dan memakai resizeBatch.
+ */
+
+static int regionValid(int imgWidth, int imgHeight, int x, int y, int width, int height) {
+    return x >= 0 && y >= 0 && width > 0 && height > 0 &&
+           width <= imgWidth - x && height <= imgHeight - y;
+}
+
+/* View rectangle di dalam img; rectangle di luar image -> view kosong
+ * (data NULL, ukuran 0). Tidak perlu di-free. */
+Image imageRegion(const Image *img, int x, int y, int width, int height) {
+    if (!img || !regionValid(img->width, img->height, x, y, width, height))
+        return imageView(NULL, 0, 0, 0);
+    return imageView(img->data + (size_t)y * img->stride + x, width, height, img->stride);
+}
+
+ImageU8 imageU8Region(const ImageU8 *img, int x, int y, int width, int height) {
+    if (!img || !regionValid(img->width, img->height, x, y, width, height))
+        return imageU8View(NULL, 0, 0, 0, 0);
+    return imageU8View(img->data + (size_t)y * img->stride + (size_t)x * img->channels,
+                       width, height, img->channels, img->stride);
+}
+
+/* Resize rectangle (x, y, width, height) dari source ke dest.
+ * Return 0 sukses, -1 jika ROI di luar source atau resize gagal. */
+int resizeRegionInto(const Image *source, int x, int y, int width, int height,
+                     Image *dest, int numThreads) {
+    Image roi = imageRegion(source, x, y, width, height);
+
+    if (!roi.data) return -1;
+    return resizeInto(&roi, dest, numThreads);
+}
+
+int resizeRegionU8Into(const ImageU8 *source, int x, int y, int width, int height,
+                       ImageU8 *dest, int numThreads) {
+    ImageU8 roi = imageU8Region(source, x, y, width, height);
+    const ResizePlan *plan;
+    int status;
+
+    if (!roi.data || !dest) return -1;
+
+    plan = acquireResizePlan(width, height, dest->width, dest->height);
+    if (!plan) return -1;
+
+    status = resizeU8Into(&roi, dest, plan, numThreads);
+    releaseResizePlan(plan);
+    return status;
+}
+
+/* Satu ROI: isi dest (sumber float) atau destU8 (sumber 8-bit) */
+typedef struct {
+    int x, y, width, height;
+    Image *dest;
+    ImageU8 *destU8;
+    int status;         /* output: 0 sukses, -1 gagal */
+} ResizeRoi;
+
+/* Resize banyak ROI dari satu sumber (isi source atau sourceU8).
+ * Return jumlah ROI yang gagal, status per ROI di rois[i].status. */
+int resizeRoiBatch(const Image *source, const ImageU8 *sourceU8,
+                   ResizeRoi *rois, int count, int numThreads) {
+    ResizeJob *jobs;
+    Image *views = NULL;
+    ImageU8 *viewsU8 = NULL;
+    int i, failed;
+
+    if (count <= 0) return 0;
+
+    jobs = (ResizeJob*)calloc(count, sizeof(ResizeJob));
+    if (source) views = (Image*)malloc(count * sizeof(Image));
+    else viewsU8 = (ImageU8*)malloc(count * sizeof(ImageU8));
+    if (!jobs || (!views && !viewsU8)) {
+        free(jobs);
+        free(views);
+        free(viewsU8);
+        for (i = 0; i < count; i++) rois[i].status = -1;
+        return count;
+    }
+
+    /* ROI tidak valid -> job kosong, resizeBatch menandainya gagal */
+    for (i = 0; i < count; i++) {
+        ResizeRoi *r = &rois[i];
+
+        if (views) {
+            views[i] = imageRegion(source, r->x, r->y, r->width, r->height);
+            if (views[i].data) {
+                jobs[i].source = &views[i];
+                jobs[i].dest = r->dest;
+            }
+        } else {
+            viewsU8[i] = imageU8Region(sourceU8, r->x, r->y, r->width, r->height);
+            if (viewsU8[i].data) {
+                jobs[i].sourceU8 = &viewsU8[i];
+                jobs[i].destU8 = r->destU8;
+            }
+        }
+    }
+
+    failed = resizeBatch(jobs, count, numThreads);
+    for (i = 0; i < count; i++) rois[i].status = jobs[i].status;
+
+    free(jobs);
+    free(views);
+    free(viewsU8);
+    return failed;
+}
+
+/* ============================================================================
+ * DIRTY RECTANGLE: RESIZE ULANG INKREMENTAL
+ * ============================================================================
+ * Untuk preview kanvas besar yang diedit sebagian: dest berisi hasil
+ * resize lama (resizeInto / path plan, geometri sama), caller memberi
+ * daftar rectangle sumber yang berubah. Hanya pixel tujuan yang footprint
+ * 2x2-nya (index0/index1 plan) menyentuh rectangle itu yang dihitung ulang,
+ * jadi biaya sebanding luas edit, bukan luas frame.
+ *
+ * Index plan monoton naik, jadi rentang kolom/baris tujuan per rectangle
+ * cukup dicari dengan binary search. Rectangle tujuan digabung dulu agar
+ * pixel yang sama tidak dihitung dua kali, lalu tiap rectangle diisi lewat
+ * sub-plan (planColumnWindow + planRowWindow) ke view dest.
+ * Hasil bit-identik dengan resizeInto untuk input finite.
+ */
+
+typedef struct {
+    int x, y, width, height;
+} DirtyRect;
+
+/* Index pertama i di [0, size) dengan table[i] >= value (size jika tidak ada) */
+static int firstIndexAtLeast(const int *table, int size, int value) {
+    int lo = 0, hi = size;
+
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+
+        if (table[mid] < value) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/* Rentang tujuan [*lo, *hi) yang membaca sumber [s0, s1) lewat index0/index1 */
+static void dirtyAxisRange(const int *index0, const int *index1, int dstSize,
+                           int s0, int s1, int *lo, int *hi) {
+    *lo = firstIndexAtLeast(index1, dstSize, s0);
+    *hi = firstIndexAtLeast(index0, dstSize, s1);
+}
+
+static int rectsTouch(const DirtyRect *a, const DirtyRect *b) {
+    return a->x <= b->x + b->width && b->x <= a->x + a->width &&
+           a->y <= b->y + b->height && b->y <= a->y + a->height;
+}
+
+static long long rectArea(const DirtyRect *r) {
+    return (long long)r->width * r->height;
+}
+
+/* Gabung rectangle yang overlap atau bersentuhan menjadi bounding box,
+ * selama bounding box tidak lebih luas dari jumlah luas keduanya (bentuk L
+ * tetap terpisah supaya tidak menghitung area yang tidak kotor).
+ * Rectangle kosong dibuang. In-place, return jumlah rectangle tersisa. */
+int coalesceDirtyRects(DirtyRect *rects, int count) {
+    int i, j, n = 0, merged = 1;
+
+    for (i = 0; i < count; i++) {
+        if (rects[i].width > 0 && rects[i].height > 0) rects[n++] = rects[i];
+    }
+
+    while (merged) {
+        merged = 0;
+        for (i = 0; i < n; i++) {
+            for (j = i + 1; j < n; j++) {
+                DirtyRect box;
+                int x1, y1;
+
+                if (!rectsTouch(&rects[i], &rects[j])) continue;
+
+                box.x = rects[i].x < rects[j].x ? rects[i].x : rects[j].x;
+                box.y = rects[i].y < rects[j].y ? rects[i].y : rects[j].y;
+                x1 = rects[i].x + rects[i].width;
+                if (rects[j].x + rects[j].width > x1) x1 = rects[j].x + rects[j].width;
+                y1 = rects[i].y + rects[i].height;
+                if (rects[j].y + rects[j].height > y1) y1 = rects[j].y + rects[j].height;
+                box.width = x1 - box.x;
+                box.height = y1 - box.y;
+                if (rectArea(&box) > rectArea(&rects[i]) + rectArea(&rects[j])) continue;
+
+                rects[i] = box;
+                rects[j--] = rects[--n];
+                merged = 1;
+            }
+        }
+    }
+    return n;
+}
+
+/* Hitung ulang bagian dest yang dipengaruhi rectangle sumber rects[0..count).
+ * Rectangle dipotong ke batas sumber; yang kosong setelah dipotong diabaikan.
+ * Return 0 sukses, -1 jika argumen tidak valid atau alokasi gagal. */
+int resizeDirtyInto(const Image *source, Image *dest, const DirtyRect *rects,
+                    int count, int numThreads) {
+    const ResizePlan *plan;
+    DirtyRect *dirty;
+    int i, n = 0, status = 0;
+
+    if (!source || !dest || !dest->data || dest->stride < dest->width ||
+        count < 0 || (count > 0 && !rects))
+        return -1;
+    if (count == 0) return 0;
+
+    plan = acquireResizePlan(source->width, source->height, dest->width, dest->height);
+    if (!plan) return -1;
+
+    dirty = (DirtyRect*)malloc(count * sizeof(DirtyRect));
+    if (!dirty) {
+        releaseResizePlan(plan);
+        return -1;
+    }
+
+    /* Rectangle sumber -> rectangle tujuan */
+    for (i = 0; i < count; i++) {
+        int sx0 = rects[i].x < 0 ? 0 : rects[i].x;
+        int sy0 = rects[i].y < 0 ? 0 : rects[i].y;
+        int sx1 = rects[i].width > source->width - rects[i].x
+                      ? source->width : rects[i].x + rects[i].width;
+        int sy1 = rects[i].height > source->height - rects[i].y
+                      ? source->height : rects[i].y + rects[i].height;
+        int dx0, dx1, dy0, dy1;
+
+        if (sx0 >= sx1 || sy0 >= sy1) continue;
+
+        dirtyAxisRange(plan->xIndex0, plan->xIndex1, plan->dstWidth, sx0, sx1, &dx0, &dx1);
+        dirtyAxisRange(plan->yIndex0, plan->yIndex1, plan->dstHeight, sy0, sy1, &dy0, &dy1);
+        if (dx0 >= dx1 || dy0 >= dy1) continue;
+
+        dirty[n].x = dx0;
+        dirty[n].y = dy0;
+        dirty[n].width = dx1 - dx0;
+        dirty[n].height = dy1 - dy0;
+        n++;
+    }
+
+    n = coalesceDirtyRects(dirty, n);
+    for (i = 0; i < n && status == 0; i++) {
+        const DirtyRect *r = &dirty[i];
+        ResizePlan cols = planColumnWindow(plan, r->x, r->width);
+        ResizePlan sub = planRowWindow(&cols, r->y, r->height);
+        Image view = imageRegion(dest, r->x, r->y, r->width, r->height);
+        Image src = *source;
+
+        /* Decimate memakai koordinat relatif (n*x, n*y): geser view sumber
+         * supaya tetap lewat fast path yang sama dengan resize penuh */
+        if (plan->ratio == RATIO_DECIMATE) {
+            int f = plan->ratioFactor;
+
+            src = imageRegion(source, f * r->x, f * r->y,
+                              source->width - f * r->x, source->height - f * r->y);
+            sub.ratio = RATIO_DECIMATE;
+        }
+        status = resizeRowsAuto(&src, &view, &sub, numThreads);
+    }
+
+    free(dirty);
+    releaseResizePlan(plan);
+    return status;
+}
+
+/* ============================================================================
+ * DOWNSCALE BESAR: BOX 2x2, AREA AVERAGE, MIPMAP
+ * ============================================================================
+ * Bilinear hanya membaca 4 pixel per output; untuk rasio kecil (8192 ->
+ * 512) sisanya diabaikan dan hasilnya aliasing. Dua alternatif:
+ *  - Mipmap: reduksi box 2x2 berulang (tiap level 1/4 data, bandwidth
+ *    bound) sampai < 2x ukuran tujuan, lalu satu langkah bilinear.
+ *  - Area average: tiap pixel tujuan = rata-rata berbobot area sumber
+ *    [i*s, (i+1)*s) yang ditutupnya (mapping top-left sama dengan plan).
+ *    Biaya sebanding ukuran sumber, bukan ukuran tujuan.
+ */
+
+/* Satu baris box 2x2: out[x] = ((r0[2x] + r0[2x+1]) + (r1[2x] + r1[2x+1])) / 4.
+ * Urutan penjumlahan sama di scalar dan SSE, jadi hasilnya bit-identik. */
+static void box2xRowScalar(const float *r0, const float *r1, float *out, int x, int dstWidth) {
+    int c;
+
+    for (; x < dstWidth; x++) {
+        for (c = 0; c < 3; c++) {
+            out[3 * x + c] = ((r0[6 * x + c] + r0[6 * x + 3 + c]) +
+                              (r1[6 * x + c] + r1[6 * x + 3 + c])) * 0.25f;
+        }
+    }
+}
+
+static void box2xRow(const float *r0, const float *r1, float *out, int dstWidth) {
+    int x = 0;
+
+#if defined(HAVE_X86_KERNELS) && defined(__SSE2__)
+    /* Load/store 4 float per pixel seperti horizontalSse41; pixel terakhir
+     * lewat scalar supaya tidak membaca/menulis lewat ujung baris */
+    const __m128 quarter = _mm_set1_ps(0.25f);
+
+    for (; x < dstWidth - 1; x++) {
+        __m128 a = _mm_add_ps(_mm_loadu_ps(r0 + 6 * x), _mm_loadu_ps(r0 + 6 * x + 3));
+        __m128 b = _mm_add_ps(_mm_loadu_ps(r1 + 6 * x), _mm_loadu_ps(r1 + 6 * x + 3));
+        _mm_storeu_ps(out + 3 * x, _mm_mul_ps(_mm_add_ps(a, b), quarter));
+    }
+#endif
+    box2xRowScalar(r0, r1, out, x, dstWidth);
+}
+
+/* dest harus berukuran (width/2, height/2); kolom/baris ganjil terakhir
+ * diabaikan. Return 0 sukses, -1 jika ukuran tidak cocok. */
+int box2xInto(const Image *source, Image *dest, int numThreads) {
+    int y;
+
+    if (!source || !dest || dest->width != source->width / 2 ||
+        dest->height != source->height / 2 || dest->width < 1 || dest->height < 1 ||
+        dest->stride < dest->width)
+        return -1;
+
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1)
+#endif
+    for (y = 0; y < dest->height; y++) {
+        const Pixel *r0 = source->data + (size_t)(2 * y) * source->stride;
+        box2xRow((const float*)r0, (const float*)(r0 + source->stride),
+                 (float*)(dest->data + (size_t)y * dest->stride), dest->width);
+    }
+    (void)numThreads;
+    return 0;
+}
+
+Image* box2x(const Image *source, int numThreads) {
+    Image *dest;
+
+    if (!source || source->width < 2 || source->height < 2) return NULL;
+    dest = createImageUninit(source->width / 2, source->height / 2);
+    if (!dest) return NULL;
+
+    if (box2xInto(source, dest, numThreads) != 0) {
+        freeImage(dest);
+        return NULL;
+    }
+    return dest;
+}
+
+/* Mipmap: box 2x2 selama level/2 masih >= tujuan di kedua sumbu, lalu
+ * bilinear (plan) dari level terakhir ke dest. */
+int resizeMipmapInto(const Image *source, Image *dest, int numThreads) {
+    const Image *level = source;
+    Image *owned = NULL;
+    const ResizePlan *plan;
+    int status;
+
+    if (!source || !dest) return -1;
+
+    while (level->width / 2 >= dest->width && level->height / 2 >= dest->height) {
+        Image *next = box2x(level, numThreads);
+
+        freeImage(owned);
+        if (!next) return -1;
+        level = owned = next;
+    }
+
+    plan = acquireResizePlan(level->width, level->height, dest->width, dest->height);
+    status = plan ? resizeIntoPlan(level, dest, plan, numThreads) : -1;
+    releaseResizePlan(plan);
+    freeImage(owned);
+    return status;
+}
+
+Image* resizeMipmap(const Image *source, int newWidth, int newHeight, int numThreads) {
+    Image *dest;
+
+    if (newWidth < 1 || newHeight < 1) return NULL;
+    dest = createImageUninit(newWidth, newHeight);
+    if (!dest) return NULL;
+
+    if (resizeMipmapInto(source, dest, numThreads) != 0) {
+        freeImage(dest);
+        return NULL;
+    }
+    return dest;
+}
+
+/* Tabel area satu sumbu: output i = sum weight[i*maxTaps + k] * src[start[i] + k] */
+typedef struct {
+    int *start;
+    int *taps;
+    float *weight;
+    int maxTaps;
+} AreaTable;
+
+static void freeAreaTable(AreaTable *t) {
+    free(t->start);
+    free(t->taps);
+    free(t->weight);
+}
+
+static int buildAreaTable(AreaTable *t, int srcSize, int dstSize) {
+    double scale = (double)srcSize / dstSize;
+    int i, k;
+
+    t->maxTaps = (int)ceil(scale) + 1;
+    t->start = (int*)malloc(dstSize * sizeof(int));
+    t->taps = (int*)malloc(dstSize * sizeof(int));
+    t->weight = (float*)malloc((size_t)dstSize * t->maxTaps * sizeof(float));
+    if (!t->start || !t->taps || !t->weight) {
+        freeAreaTable(t);
+        return -1;
+    }
+
+    for (i = 0; i < dstSize; i++) {
+        double a = i * scale;
+        double b = (i + 1) * scale;
+        int j0 = (int)a;
+        int j1 = (int)ceil(b);
+
+        if (b > srcSize) b = srcSize;
+        if (j1 > srcSize) j1 = srcSize;
+        if (j1 - j0 > t->maxTaps) j1 = j0 + t->maxTaps;
+
+        t->start[i] = j0;
+        t->taps[i] = j1 - j0;
+        for (k = 0; k < t->maxTaps; k++) {
+            double lo = (j0 + k > a) ? j0 + k : a;
+            double hi = (j0 + k + 1 < b) ? j0 + k + 1 : b;
+            t->weight[i * t->maxTaps + k] = (k < j1 - j0 && hi > lo) ? (float)((hi - lo) / (b - a)) : 0.0f;
+        }
+    }
+    return 0;
+}
+
+/* Reduksi horizontal satu baris sumber, hasil diakumulasi: acc += wy * row */
+static void areaAccumulateRow(const Pixel *srcRow, const AreaTable *xt, int dstWidth,
+                              float wy, float *acc) {
+    int x, k;
+
+    for (x = 0; x < dstWidth; x++) {
+        const Pixel *p = srcRow + xt->start[x];
+        const float *w = xt->weight + (size_t)x * xt->maxTaps;
+        float r = 0.0f, g = 0.0f, b = 0.0f;
+
+        for (k = 0; k < xt->taps[x]; k++) {
+            r += w[k] * p[k].r;
+            g += w[k] * p[k].g;
+            b += w[k] * p[k].b;
+        }
+        acc[3 * x + 0] += wy * r;
+        acc[3 * x + 1] += wy * g;
+        acc[3 * x + 2] += wy * b;
+    }
+}
+
+/* Area average ke dest (ukuran bebas, ditujukan untuk downscale).
+ * Return 0 sukses, -1 gagal. */
+int resizeAreaInto(const Image *source, Image *dest, int numThreads) {
+    AreaTable xt, yt;
+
+    if (!source || !dest || dest->width < 1 || dest->height < 1 || dest->stride < dest->width)
+        return -1;
+    if (buildAreaTable(&xt, source->width, dest->width) != 0) return -1;
+    if (buildAreaTable(&yt, source->height, dest->height) != 0) {
+        freeAreaTable(&xt);
+        return -1;
+    }
+
+#ifdef USE_OPENMP
+    #pragma omp parallel num_threads(numThreads) if(numThreads > 1)
+#endif
+    {
+        /* Akumulator langsung di baris dest (float RGB) */
+        int y, k;
+
+#ifdef USE_OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (y = 0; y < dest->height; y++) {
+            float *acc = (float*)(dest->data + (size_t)y * dest->stride);
+            const float *wy = yt.weight + (size_t)y * yt.maxTaps;
+
+            memset(acc, 0, dest->width * sizeof(Pixel));
+            for (k = 0; k < yt.taps[y]; k++) {
+                areaAccumulateRow(source->data + (size_t)(yt.start[y] + k) * source->stride,
+                                  &xt, dest->width, wy[k], acc);
+            }
+        }
+    }
+    (void)numThreads;
+
+    freeAreaTable(&xt);
+    freeAreaTable(&yt);
+    return 0;
+}
+
+Image* resizeArea(const Image *source, int newWidth, int newHeight, int numThreads) {
+    Image *dest;
+
+    if (newWidth < 1 || newHeight < 1) return NULL;
+    dest = createImageUninit(newWidth, newHeight);
+    if (!dest) return NULL;
+
+    if (resizeAreaInto(source, dest, numThreads) != 0) {
+        freeImage(dest);
+        return NULL;
+    }
+    return dest;
+}
+
+/* ============================================================================
+ * PYRAMID MULTI-RESOLUSI SATU PASS
+ * ============================================================================
+ * Semua level dihasilkan sambil membaca sumber sekali dari atas ke bawah.
+ * Level diurutkan dari yang terbesar; tiap level diturunkan dari level
+ * terkecil yang sudah ada dan masih >= ukurannya (atau dari sumber):
+ * box 2x2 jika tepat setengah, selain itu ResizeStream bilinear. Baris yang
+ * selesai langsung diteruskan ke level anak selagi masih di cache, jadi
+ * level kecil tidak pernah membaca ulang sumber resolusi penuh.
+ */
+
+typedef struct Pyramid Pyramid;
+
+typedef struct {
+    Pyramid *owner;
+    Image *image;
+    ResizeStream *stream;   /* NULL = box 2x2 dari parent */
+    const Pixel *evenRow;   /* box: baris genap parent yang menunggu pasangan */
+    int parent;             /* index level parent, -1 = sumber */
+    int rowsDone;
+} PyramidLevel;
+
+struct Pyramid {
+    PyramidLevel *levels;
+    int count;
+};
+
+static void pyramidFeed(Pyramid *pyr, int parent, int y, const Pixel *row);
+
+/* Baris y level selesai (sudah di image): teruskan ke anak-anaknya */
+static void pyramidEmit(Pyramid *pyr, int index, int y) {
+    PyramidLevel *level = &pyr->levels[index];
+
+    level->rowsDone++;
+    pyramidFeed(pyr, index, y, level->image->data + (size_t)y * level->image->stride);
+}
+
+static void pyramidSink(void *userData, int y, const Pixel *row) {
+    PyramidLevel *level = (PyramidLevel*)userData;
+    Image *image = level->image;
+
+    memcpy(image->data + (size_t)y * image->stride, row, image->width * sizeof(Pixel));
+    pyramidEmit(level->owner, (int)(level - level->owner->levels), y);
+}
+
+/* Baris y dari parent (row tetap valid: baris sumber atau baris image level) */
+static void pyramidFeed(Pyramid *pyr, int parent, int y, const Pixel *row) {
+    int i;
+
+    for (i = 0; i < pyr->count; i++) {
+        PyramidLevel *level = &pyr->levels[i];
+        Image *image = level->image;
+
+        if (level->parent != parent) continue;
+
+        if (level->stream) {
+            resizeStreamPush(level->stream, row);
+        } else if ((y & 1) == 0) {
+            level->evenRow = row;
+        } else if (y / 2 < image->height) {
+            box2xRow((const float*)level->evenRow, (const float*)row,
+                     (float*)(image->data + (size_t)(y / 2) * image->stride), image->width);
+            pyramidEmit(pyr, i, y / 2);
+        }
+    }
+}
+
+/* Isi semua dests[i] (sudah dialokasikan dengan ukuran target, urutan
+ * bebas) dari source dalam satu pass. Return 0 sukses, -1 gagal. */
+int resizePyramidInto(const Image *source, Image **dests, int count) {
+    Pyramid pyr;
+    int *order;
+    int i, j, y, status = 0;
+
+    if (!source || !dests || count < 1) return -1;
+    for (i = 0; i < count; i++) {
+        if (!dests[i] || dests[i]->width < 1 || dests[i]->height < 1 ||
+            dests[i]->stride < dests[i]->width)
+            return -1;
+    }
+
+    pyr.count = count;
+    pyr.levels = (PyramidLevel*)calloc(count, sizeof(PyramidLevel));
+    order = (int*)malloc(count * sizeof(int));
+    if (!pyr.levels || !order) {
+        free(pyr.levels);
+        free(order);
+        return -1;
+    }
+
+    /* Urut luas menurun (insertion sort, count kecil) */
+    for (i = 0; i < count; i++) {
+        long area = (long)dests[i]->width * dests[i]->height;
+        for (j = i; j > 0 && (long)dests[order[j - 1]]->width * dests[order[j - 1]]->height < area; j--)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+
+    for (i = 0; i < count && status == 0; i++) {
+        PyramidLevel *level = &pyr.levels[i];
+        Image *dest = dests[order[i]];
+        int parentWidth = source->width, parentHeight = source->height;
+
+        level->owner = &pyr;
+        level->image = dest;
+        level->parent = -1;
+
+        /* Prioritas parent tepat 2x (box), lalu kandidat terkecil */
+        if (parentWidth / 2 != dest->width || parentHeight / 2 != dest->height) {
+            for (j = 0; j < i; j++) {
+                const Image *cand = pyr.levels[j].image;
+                if (cand->width / 2 == dest->width && cand->height / 2 == dest->height) break;
+                if (cand->width >= dest->width && cand->height >= dest->height &&
+                    (long)cand->width * cand->height <= (long)parentWidth * parentHeight) {
+                    level->parent = j;
+                    parentWidth = cand->width;
+                    parentHeight = cand->height;
+                }
+            }
+            if (j < i) {
+                level->parent = j;
+                parentWidth = pyr.levels[j].image->width;
+                parentHeight = pyr.levels[j].image->height;
+            }
+        }
+
+        if (parentWidth / 2 != dest->width || parentHeight / 2 != dest->height) {
+            level->stream = createResizeStream(parentWidth, parentHeight, dest->width, dest->height,
+                                               pyramidSink, level);
+            if (!level->stream) status = -1;
+        }
+    }
+
+    for (y = 0; y < source->height && status == 0; y++) {
+        pyramidFeed(&pyr, -1, y, source->data + (size_t)y * source->stride);
+    }
+
+    for (i = 0; i < count; i++) {
+        if (status == 0 && pyr.levels[i].rowsDone != pyr.levels[i].image->height) status = -1;
+        freeResizeStream(pyr.levels[i].stream);
+    }
+    free(pyr.levels);
+    free(order);
+    return status;
+}
+
+/* Alokasi level widths[i] x heights[i] ke out[i] lalu isi dengan
+ * resizePyramidInto. Gagal: semua out[i] NULL, return -1. */
+int resizePyramid(const Image *source, const int *widths, const int *heights,
+                  int count, Image **out) {
+    int i, status = 0;
+
+    for (i = 0; i < count; i++) {
+        out[i] = (widths[i] > 0 && heights[i] > 0) ? createImageUninit(widths[i], heights[i]) : NULL;
+        if (!out[i]) status = -1;
+    }
+    if (status == 0) status = resizePyramidInto(source, out, count);
+
+    if (status != 0) {
+        for (i = 0; i < count; i++) {
+            freeImage(out[i]);
+            out[i] = NULL;
+        }
+    }
+    return status;
+}
+
+/* ============================================================================
+ * REMAP / WARP
+ * ============================================================================
+ * Sampling bilinear lewat peta koordinat per pixel tujuan: dest(x,y) =
+ * source(mapX, mapY). Peta bisa diisi sendiri (mis. koreksi distorsi lensa)
+ * atau dibangun dari matriks affine / homography (dipetakan dari tujuan ke
+ * sumber, seperti inverse map).
+ *
+ * Untuk peta yang dipakai berulang (video), packRemapMap mengubah peta float
+ * menjadi offset integer + indeks subpixel 5 bit per sumbu, jadi per frame
+ * tidak ada floor/clamp/konversi float lagi.
+ */
+
+#define REMAP_SUBPIXEL_BITS 5
+#define REMAP_SUBPIXEL      (1 << REMAP_SUBPIXEL_BITS)
+#define REMAP_FRAC_MASK     (REMAP_SUBPIXEL - 1)
+#define REMAP_FLAG_DX       (1 << (2 * REMAP_SUBPIXEL_BITS))       /* ada tetangga kanan */
+#define REMAP_FLAG_DY       (1 << (2 * REMAP_SUBPIXEL_BITS + 1))   /* ada tetangga bawah */
+
+typedef enum {
+    REMAP_BORDER_CLAMP,     /* koordinat di luar di-clamp ke tepi */
+    REMAP_BORDER_CONSTANT   /* koordinat di luar menghasilkan hitam */
+} RemapBorder;
+
+typedef struct {
+    int width, height;      /* ukuran tujuan */
+    float *mapX;            /* [width * height], koordinat sumber */
+    float *mapY;
+} RemapMap;
+
+typedef struct {
+    int width, height;      /* ukuran tujuan */
+    int srcWidth, srcHeight;
+    int srcStride;          /* stride sumber dalam pixel saat di-pack */
+    int32_t *offset;        /* y0 * srcStride + x0, -1 = di luar (border constant) */
+    uint16_t *frac;         /* fx | fy << 5 | REMAP_FLAG_DX | REMAP_FLAG_DY */
+} PackedRemap;
+
+void freeRemapMap(RemapMap *map) {
+    if (map) {
+        free(map->mapX);
+        free(map->mapY);
+        free(map);
+    }
+}
+
+RemapMap* createRemapMap(int width, int height) {
+    RemapMap *map;
+
+    if (width < 1 || height < 1) return NULL;
+    map = (RemapMap*)calloc(1, sizeof(RemapMap));
+    if (!map) return NULL;
+
+    map->width = width;
+    map->height = height;
+    map->mapX = (float*)malloc((size_t)width * height * sizeof(float));
+    map->mapY = (float*)malloc((size_t)width * height * sizeof(float));
+    if (!map->mapX || !map->mapY) {
+        freeRemapMap(map);
+        return NULL;
+    }
+    return map;
+}
+
+/* m = {a, b, c, d, e, f}: srcX = a*x + b*y + c, srcY = d*x + e*y + f */
+RemapMap* createAffineMap(int width, int height, const double m[6]) {
+    RemapMap *map = createRemapMap(width, height);
+    int x, y;
+
+    if (!map) return NULL;
+    for (y = 0; y < height; y++) {
+        for (x = 0; x < width; x++) {
+            size_t i = (size_t)y * width + x;
+            map->mapX[i] = (float)(m[0] * x + m[1] * y + m[2]);
+            map->mapY[i] = (float)(m[3] * x + m[4] * y + m[5]);
+        }
+    }
+    return map;
+}
+
+/* h = matriks 3x3 row-major, (srcX, srcY, w) = H * (x, y, 1) */
+RemapMap* createPerspectiveMap(int width, int height, const double h[9]) {
+    RemapMap *map = createRemapMap(width, height);
+    int x, y;
+
+    if (!map) return NULL;
+    for (y = 0; y < height; y++) {
+        for (x = 0; x < width; x++) {
+            size_t i = (size_t)y * width + x;
+            double w = h[6] * x + h[7] * y + h[8];
+
+            if (w == 0.0) {
+                /* Titik di tak hingga: jatuh di luar sumber */
+                map->mapX[i] = -1.0f;
+                map->mapY[i] = -1.0f;
+            } else {
+                map->mapX[i] = (float)((h[0] * x + h[1] * y + h[2]) / w);
+                map->mapY[i] = (float)((h[3] * x + h[4] * y + h[5]) / w);
+            }
+        }
+    }
+    return map;
+}
+
+/* Koordinat di dalam [0, size-1] setelah border; return 0 jika di luar (constant) */
+static int remapCoord(float v, int size, RemapBorder border, float *out) {
+    if (!(v >= 0.0f && v <= (float)(size - 1))) {
+        if (border == REMAP_BORDER_CONSTANT) return 0;
+        v = (v > 0.0f) ? (float)(size - 1) : 0.0f;   /* NaN -> 0 */
+    }
+    *out = v;
+    return 1;
+}
+
+static void remapRowFloat(const Image *source, const RemapMap *map, RemapBorder border,
+                          Pixel *out, int y) {
+    const float *mx = map->mapX + (size_t)y * map->width;
+    const float *my = map->mapY + (size_t)y * map->width;
+    int x;
+
+    for (x = 0; x < map->width; x++) {
+        float sx, sy, fx, fy;
+        int x0, y0, x1, y1;
+        const Pixel *r0, *r1;
+
+        if (!remapCoord(mx[x], source->width, border, &sx) ||
+            !remapCoord(my[x], source->height, border, &sy)) {
+            out[x].r = out[x].g = out[x].b = 0.0f;
+            continue;
+        }
+
+        x0 = (int)sx;
+        y0 = (int)sy;
+        x1 = mini(x0 + 1, source->width - 1);
+        y1 = mini(y0 + 1, source->height - 1);
+        fx = sx - x0;
+        fy = sy - y0;
+        r0 = source->data + (size_t)y0 * source->stride;
+        r1 = source->data + (size_t)y1 * source->stride;
+
+        {
+            float tr = r0[x0].r + fx * (r0[x1].r - r0[x0].r);
+            float tg = r0[x0].g + fx * (r0[x1].g - r0[x0].g);
+            float tb = r0[x0].b + fx * (r0[x1].b - r0[x0].b);
+            float br = r1[x0].r + fx * (r1[x1].r - r1[x0].r);
+            float bg = r1[x0].g + fx * (r1[x1].g - r1[x0].g);
+            float bb = r1[x0].b + fx * (r1[x1].b - r1[x0].b);
+
+            out[x].r = tr + fy * (br - tr);
+            out[x].g = tg + fy * (bg - tg);
+            out[x].b = tb + fy * (bb - tb);
+        }
+    }
+}
+
+/* Remap langsung dari peta float; dest harus seukuran peta.
+ * numThreads <= 1 = serial. Return 0 sukses, -1 gagal. */
+int remapInto(const Image *source, Image *dest, const RemapMap *map,
+              RemapBorder border, int numThreads) {
+    int y;
+
+    if (!source || !dest || !map || dest->width != map->width ||
+        dest->height != map->height || dest->stride < dest->width)
+        return -1;
+
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1)
+#endif
+    for (y = 0; y < map->height; y++) {
+        remapRowFloat(source, map, border, dest->data + (size_t)y * dest->stride, y);
+    }
+    (void)numThreads;
+    return 0;
+}
+
+Image* remap(const Image *source, const RemapMap *map, RemapBorder border, int numThreads) {
+    Image *dest;
+
+    if (!map) return NULL;
+    dest = createImageUninit(map->width, map->height);
+    if (!dest) return NULL;
+
+    if (remapInto(source, dest, map, border, numThreads) != 0) {
+        freeImage(dest);
+        return NULL;
+    }
+    return dest;
+}
+
+void freePackedRemap(PackedRemap *packed) {
+    if (packed) {
+        free(packed->offset);
+        free(packed->frac);
+        free(packed);
+    }
+}
+
+/* Pack peta float untuk sumber srcWidth x srcHeight dengan stride srcStride
+ * pixel. Fraksi dibulatkan ke 1/32 pixel. */
+PackedRemap* packRemapMap(const RemapMap *map, int srcWidth, int srcHeight,
+                          int srcStride, RemapBorder border) {
+    PackedRemap *packed;
+    size_t i, count;
+
+    if (!map || srcWidth < 1 || srcHeight < 1 || srcStride < srcWidth ||
+        (long)srcStride * srcHeight > INT32_MAX)
+        return NULL;
+
+    packed = (PackedRemap*)calloc(1, sizeof(PackedRemap));
+    if (!packed) return NULL;
+
+    count = (size_t)map->width * map->height;
+    packed->width = map->width;
+    packed->height = map->height;
+    packed->srcWidth = srcWidth;
+    packed->srcHeight = srcHeight;
+    packed->srcStride = srcStride;
+    packed->offset = (int32_t*)malloc(count * sizeof(int32_t));
+    packed->frac = (uint16_t*)malloc(count * sizeof(uint16_t));
+    if (!packed->offset || !packed->frac) {
+        freePackedRemap(packed);
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++) {
+        float sx, sy;
+        int x0, y0, fx, fy;
+
+        if (!remapCoord(map->mapX[i], srcWidth, border, &sx) ||
+            !remapCoord(map->mapY[i], srcHeight, border, &sy)) {
+            packed->offset[i] = -1;
+            packed->frac[i] = 0;
+            continue;
+        }
+
+        x0 = (int)sx;
+        y0 = (int)sy;
+        fx = (int)lrintf((sx - x0) * REMAP_SUBPIXEL);
+        fy = (int)lrintf((sy - y0) * REMAP_SUBPIXEL);
+        if (fx == REMAP_SUBPIXEL) { x0++; fx = 0; }
+        if (fy == REMAP_SUBPIXEL) { y0++; fy = 0; }
+
+        packed->offset[i] = (int32_t)((long)y0 * srcStride + x0);
+        packed->frac[i] = (uint16_t)(fx | (fy << REMAP_SUBPIXEL_BITS) |
+                                     (x0 < srcWidth - 1 ? REMAP_FLAG_DX : 0) |
+                                     (y0 < srcHeight - 1 ? REMAP_FLAG_DY : 0));
+    }
+    return packed;
+}
+
+static void remapRowPacked(const Image *source, const PackedRemap *packed, Pixel *out, int y) {
+    const int32_t *offset = packed->offset + (size_t)y * packed->width;
+    const uint16_t *frac = packed->frac + (size_t)y * packed->width;
+    const float scale = 1.0f / REMAP_SUBPIXEL;
+    int x;
+
+    for (x = 0; x < packed->width; x++) {
+        const Pixel *p00, *p01, *p10, *p11;
+        unsigned f = frac[x];
+        float fx, fy;
+
+        if (offset[x] < 0) {
+            out[x].r = out[x].g = out[x].b = 0.0f;
+            continue;
+        }
+
+        fx = (f & REMAP_FRAC_MASK) * scale;
+        fy = ((f >> REMAP_SUBPIXEL_BITS) & REMAP_FRAC_MASK) * scale;
+        p00 = source->data + offset[x];
+        p01 = p00 + ((f & REMAP_FLAG_DX) ? 1 : 0);
+        p10 = p00 + ((f & REMAP_FLAG_DY) ? source->stride : 0);
+        p11 = p10 + (p01 - p00);
+
+        {
+            float tr = p00->r + fx * (p01->r - p00->r);
+            float tg = p00->g + fx * (p01->g - p00->g);
+            float tb = p00->b + fx * (p01->b - p00->b);
+            float br = p10->r + fx * (p11->r - p10->r);
+            float bg = p10->g + fx * (p11->g - p10->g);
+            float bb = p10->b + fx * (p11->b - p10->b);
+
+            out[x].r = tr + fy * (br - tr);
+            out[x].g = tg + fy * (bg - tg);
+            out[x].b = tb + fy * (bb - tb);
+        }
+    }
+}
+
+/* Remap dengan peta packed; source harus cocok dengan ukuran/stride saat
+ * di-pack. Return 0 sukses, -1 gagal. */
+int remapPackedInto(const Image *source, Image *dest, const PackedRemap *packed, int numThreads) {
+    int y;
+
+    if (!source || !dest || !packed || source->width != packed->srcWidth ||
+        source->height != packed->srcHeight || source->stride != packed->srcStride ||
+        dest->width != packed->width || dest->height != packed->height ||
+        dest->stride < dest->width)
+        return -1;
+
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1)
+#endif
+    for (y = 0; y < packed->height; y++) {
+        remapRowPacked(source, packed, dest->data + (size_t)y * dest->stride, y);
+    }
+    (void)numThreads;
+    return 0;
+}
+
+/* 8-bit: bobot subpixel jadi Q14 lalu aritmetika sama dengan resize 8-bit;
+ * CH konstan per varian seperti DEFINE_HORIZONTAL_U8 */
+#define DEFINE_REMAP_ROW_U8(CH)                                                \
+static void remapRowPackedU8_##CH(const ImageU8 *source, const PackedRemap *packed, \
+                                  uint8_t *out, int y) {                       \
+    const int32_t *offset = packed->offset + (size_t)y * packed->width;        \
+    const uint16_t *frac = packed->frac + (size_t)y * packed->width;           \
+    const int shift = FIXED_SHIFT - REMAP_SUBPIXEL_BITS;                       \
+    int x, c;                                                                  \
+    for (x = 0; x < packed->width; x++, out += CH) {                           \
+        const uint8_t *p00, *p01, *p10, *p11;                                  \
+        unsigned f = frac[x];                                                  \
+        int wx, wy;                                                            \
+        if (offset[x] < 0) {                                                   \
+            for (c = 0; c < CH; c++) out[c] = 0;                               \
+            continue;                                                          \
+        }                                                                      \
+        wx = (int)(f & REMAP_FRAC_MASK) << shift;                              \
+        wy = (int)((f >> REMAP_SUBPIXEL_BITS) & REMAP_FRAC_MASK) << shift;     \
+        p00 = source->data + (size_t)offset[x] * CH;                           \
+        p01 = p00 + ((f & REMAP_FLAG_DX) ? CH : 0);                            \
+        p10 = p00 + ((f & REMAP_FLAG_DY) ? source->stride : 0);                \
+        p11 = p10 + (p01 - p00);                                               \
+        for (c = 0; c < CH; c++) {                                             \
+            int top = (p00[c] * (FIXED_ONE - wx) + p01[c] * wx + MID_ROUND)    \
+                      >> (FIXED_SHIFT - MID_SHIFT);                            \
+            int bot = (p10[c] * (FIXED_ONE - wx) + p11[c] * wx + MID_ROUND)    \
+                      >> (FIXED_SHIFT - MID_SHIFT);                            \
+            out[c] = (uint8_t)((top * (FIXED_ONE - wy) + bot * wy + OUT_ROUND) >> OUT_SHIFT); \
+        }                                                                      \
+    }                                                                          \
+}
+
+DEFINE_REMAP_ROW_U8(1)
+DEFINE_REMAP_ROW_U8(3)
+DEFINE_REMAP_ROW_U8(4)
+
+static void remapRowPackedU8(const ImageU8 *source, const PackedRemap *packed,
+                             uint8_t *out, int y) {
+    switch (source->channels) {
+        case 1: remapRowPackedU8_1(source, packed, out, y); break;
+        case 3: remapRowPackedU8_3(source, packed, out, y); break;
+        default: remapRowPackedU8_4(source, packed, out, y); break;
+    }
+}
+
+/* Versi 8-bit; stride sumber (byte) harus srcStride * channels */
+int remapPackedU8Into(const ImageU8 *source, ImageU8 *dest, const PackedRemap *packed,
+                      int numThreads) {
+    int y;
+
+    if (!source || !dest || !packed || !u8ChannelsSupported(source->channels) ||
+        source->channels != dest->channels ||
+        source->width != packed->srcWidth || source->height != packed->srcHeight ||
+        source->stride != packed->srcStride * source->channels ||
+        dest->width != packed->width || dest->height != packed->height ||
+        dest->stride < dest->width * dest->channels)
+        return -1;
+
+#ifdef USE_OPENMP
+    #pragma omp parallel for schedule(static) num_threads(numThreads) if(numThreads > 1)
+#endif
+    for (y = 0; y < packed->height; y++) {
+        remapRowPackedU8(source, packed, dest->data + (size_t)y * dest->stride, y);
+    }
+    (void)numThreads;
+    return 0;
+}
+
+/* ============================================================================
+ * WORKER POOL PERSISTEN & RESIZE CONTEXT
+ * ============================================================================
+ * Thread dibuat sekali (opsional di-pin ke CPU) dan dipakai ulang untuk
+ * setiap resize, jadi latency tidak lagi didominasi start-up region
+ * OpenMP. Thread count per panggilan hanya hint: tidak ada state global
+ * yang diubah. Caller ikut bekerja sebagai worker 0. Worker spin sebentar
+ * sebelum tidur di condvar supaya request beruntun tidak kena wake-up.
+ */
+
+#ifdef HAVE_PTHREADS
+
+#define POOL_SPIN_ITERATIONS 20000
+
+/* worker = 0..numWorkers-1 */
+typedef void (*PoolTask)(void *arg, int worker, int numWorkers);
+
+typedef struct WorkerPool WorkerPool;
+
+typedef struct {
+    WorkerPool *pool;
+    int index;
+} PoolWorkerArg;
+
+struct WorkerPool {
+    pthread_t *threads;
+    PoolWorkerArg *args;
+    int size;                   /* total worker termasuk caller */
+    int spin;                   /* iterasi spin sebelum tidur */
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    unsigned long generation;   /* naik setiap run baru */
+    PoolTask task;
+    void *taskArg;
+    int active;                 /* worker yang ikut run ini */
+    int pending;                /* worker background yang belum selesai */
+    int shutdown;
+};
+
+static void cpuRelax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+static void* poolWorkerMain(void *param) {
+    PoolWorkerArg *self = (PoolWorkerArg*)param;
+    WorkerPool *pool = self->pool;
+    unsigned long seen = 0;
+
+    for (;;) {
+        PoolTask task;
+        void *arg;
+        int active, i;
+
+        for (i = 0; i < pool->spin &&
+                    __atomic_load_n(&pool->generation, __ATOMIC_ACQUIRE) == seen; i++) {
+            cpuRelax();
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        while (pool->generation == seen && !pool->shutdown)
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        if (pool->shutdown) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        seen = pool->generation;
+        task = pool->task;
+        arg = pool->taskArg;
+        active = pool->active;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (self->index >= active) continue;
+
+        task(arg, self->index, active);
+
+        if (__atomic_sub_fetch(&pool->pending, 1, __ATOMIC_ACQ_REL) == 0) {
+            pthread_mutex_lock(&pool->lock);
+            pthread_cond_signal(&pool->done);
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+    return NULL;
+}
+
+/* Pin worker ke CPU ke-(index) dari affinity mask proses */
+static void pinWorker(pthread_t thread, int index) {
+    cpu_set_t allowed, target;
+    int cpu, n = 0, count;
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+    count = CPU_COUNT(&allowed);
+    if (count <= 0) return;
+
+    for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) continue;
+        if (n++ == index % count) {
+            CPU_ZERO(&target);
+            CPU_SET(cpu, &target);
+            pthread_setaffinity_np(thread, sizeof(target), &target);
+            return;
+        }
+    }
+}
+
+void freeWorkerPool(WorkerPool *pool) {
+    int i;
+
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 1; i < pool->size; i++) {
+        if (pool->args[i].pool) pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->done);
+    free(pool->threads);
+    free(pool->args);
+    free(pool);
+}
+
+/* size = jumlah worker termasuk caller; pin = 1 untuk set CPU affinity */
+WorkerPool* createWorkerPool(int size, int pin) {
+    WorkerPool *pool;
+    int i;
+
+    if (size < 1) size = 1;
+
+    pool = (WorkerPool*)calloc(1, sizeof(WorkerPool));
+    if (!pool) return NULL;
+
+    pool->size = size;
+    /* Spin hanya jika tiap worker punya CPU sendiri; oversubscribed
+     * spin justru merebut CPU dari worker yang sedang bekerja */
+    pool->spin = (size <= sysconf(_SC_NPROCESSORS_ONLN)) ? POOL_SPIN_ITERATIONS : 0;
+    pool->threads = (pthread_t*)calloc(size, sizeof(pthread_t));
+    pool->args = (PoolWorkerArg*)calloc(size, sizeof(PoolWorkerArg));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    if (!pool->threads || !pool->args) {
+        freeWorkerPool(pool);
+        return NULL;
+    }
+
+    for (i = 1; i < size; i++) {
+        pool->args[i].pool = pool;
+        pool->args[i].index = i;
+        if (pthread_create(&pool->threads[i], NULL, poolWorkerMain, &pool->args[i]) != 0) {
+            pool->args[i].pool = NULL;
+            freeWorkerPool(pool);
+            return NULL;
+        }
+        if (pin) pinWorker(pool->threads[i], i);
+    }
+
+    return pool;
+}
+
+/* Jalankan task di numWorkers worker (dibatasi ukuran pool), blocking
+ * sampai semua selesai. Tidak reentrant: satu run per pool pada satu waktu. */
+void workerPoolRun(WorkerPool *pool, PoolTask task, void *arg, int numWorkers) {
+    int i;
+
+    if (numWorkers > pool->size) numWorkers = pool->size;
+    if (numWorkers < 1) numWorkers = 1;
+
+    if (numWorkers > 1) {
+        pthread_mutex_lock(&pool->lock);
+        pool->task = task;
+        pool->taskArg = arg;
+        pool->active = numWorkers;
+        __atomic_store_n(&pool->pending, numWorkers - 1, __ATOMIC_RELEASE);
+        __atomic_add_fetch(&pool->generation, 1, __ATOMIC_RELEASE);
+        pthread_cond_broadcast(&pool->wake);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    task(arg, 0, numWorkers);
+
+    if (numWorkers > 1) {
+        for (i = 0; i < pool->spin &&
+                    __atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) > 0; i++) {
+            cpuRelax();
+        }
+        pthread_mutex_lock(&pool->lock);
+        while (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) > 0)
+            pthread_cond_wait(&pool->done, &pool->lock);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+/* Context: pool + scratch row cache per worker yang dipakai ulang */
+typedef struct {
+    WorkerPool *pool;
+    const ResizeKernels *kernels;
+    void **scratch;             /* [pool->size] */
+    size_t *scratchBytes;
+} ResizeContext;
+
+void freeResizeContext(ResizeContext *ctx) {
+    int i;
+
+    if (!ctx) return;
+    if (ctx->scratch) {
+        for (i = 0; i < ctx->pool->size; i++) free(ctx->scratch[i]);
+    }
+    free(ctx->scratch);
+    free(ctx->scratchBytes);
+    freeWorkerPool(ctx->pool);
+    free(ctx);
+}
+
+/* numThreads = ukuran pool (termasuk caller); pin = CPU affinity worker */
+ResizeContext* createResizeContext(int numThreads, int pin) {
+    ResizeContext *ctx = (ResizeContext*)calloc(1, sizeof(ResizeContext));
+
+    if (!ctx) return NULL;
+
+    ctx->pool = createWorkerPool(numThreads, pin);
+    if (!ctx->pool) {
+        free(ctx);
+        return NULL;
+    }
+    ctx->kernels = getResizeKernels();
+    ctx->scratch = (void**)calloc(ctx->pool->size, sizeof(void*));
+    ctx->scratchBytes = (size_t*)calloc(ctx->pool->size, sizeof(size_t));
+    if (!ctx->scratch || !ctx->scratchBytes) {
+        freeResizeContext(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+int resizeContextThreads(const ResizeContext *ctx) {
+    return ctx->pool->size;
+}
+
+/* Scratch worker minimal bytes; hanya realloc jika perlu tumbuh */
+static void* contextScratch(ResizeContext *ctx, int worker, size_t bytes) {
+    if (ctx->scratchBytes[worker] < bytes) {
+        void *p = realloc(ctx->scratch[worker], bytes);
+        if (!p) return NULL;
+        ctx->scratch[worker] = p;
+        ctx->scratchBytes[worker] = bytes;
+    }
+    return ctx->scratch[worker];
+}
+
+typedef struct {
+    ResizeContext *ctx;
+    const ResizePlan *plan;
+    const Image *source;
+    Image *dest;
+    const ImageU8 *sourceU8;
+    ImageU8 *destU8;
+    int failed;
+} ContextResizeTask;
+
+/* Tiap worker: blok baris tujuan berurutan dengan row cache sendiri */
+static void contextResizeWorker(void *arg, int worker, int numWorkers) {
+    ContextResizeTask *t = (ContextResizeTask*)arg;
+    const ResizePlan *plan = t->plan;
+    int y0 = (int)((long)plan->dstHeight * worker / numWorkers);
+    int y1 = (int)((long)plan->dstHeight * (worker + 1) / numWorkers);
+    int y;
+
+    if (t->source) {
+        int lanes = 3 * plan->dstWidth;
+        RowCache cache;
+
+        cache.rows[0] = (float*)contextScratch(t->ctx, worker, 2 * (size_t)lanes * sizeof(float));
+        if (!cache.rows[0]) {
+            __atomic_store_n(&t->failed, 1, __ATOMIC_RELAXED);
+            return;
+        }
+        cache.rows[1] = cache.rows[0] + lanes;
+        cache.srcY[0] = cache.srcY[1] = -1;
+
+        for (y = y0; y < y1; y++) {
+            resizeRowCached(t->source, plan, t->ctx->kernels, &cache,
+                            t->dest->data + (size_t)y * t->dest->stride, y);
+        }
+    } else {
+        int lanes = t->sourceU8->channels * plan->dstWidth;
+        RowCacheU8 cache;
+
+        cache.rows[0] = (int16_t*)contextScratch(t->ctx, worker, 2 * (size_t)lanes * sizeof(int16_t));
+        if (!cache.rows[0]) {
+            __atomic_store_n(&t->failed, 1, __ATOMIC_RELAXED);
+            return;
+        }
+        cache.rows[1] = cache.rows[0] + lanes;
+        cache.srcY[0] = cache.srcY[1] = -1;
+
+        for (y = y0; y < y1; y++) {
+            resizeRowU8(t->sourceU8, plan, &cache,
+                        t->destU8->data + (size_t)y * t->destU8->stride, y);
+        }
+    }
+}
+
+/* Jumlah worker efektif: hint dibatasi pool dan jumlah baris tujuan */
+static int contextWorkers(const ResizeContext *ctx, const ResizePlan *plan, int threadsHint) {
+    int n = (threadsHint > 0) ? threadsHint : ctx->pool->size;
+    if (n > plan->dstHeight) n = plan->dstHeight;
+    return n;
+}
+
+/* Resize float ke dest memakai pool context. threadsHint <= 0 = semua
+ * worker. Return 0 sukses, -1 jika ukuran tidak cocok / alokasi gagal. */
+int resizeContextInto(ResizeContext *ctx, const Image *source, Image *dest,
+                      const ResizePlan *plan, int threadsHint) {
+    ContextResizeTask task;
+
+    if (!ctx || !source || !dest || dest->stride < dest->width ||
+        !planMatches(plan, source->width, source->height, dest->width, dest->height))
+        return -1;
+
+    memset(&task, 0, sizeof(task));
+    task.ctx = ctx;
+    task.plan = plan;
+    task.source = source;
+    task.dest = dest;
+    workerPoolRun(ctx->pool, contextResizeWorker, &task, contextWorkers(ctx, plan, threadsHint));
+    return task.failed ? -1 : 0;
+}
+
+int resizeContextU8Into(ResizeContext *ctx, const ImageU8 *source, ImageU8 *dest,
+                        const ResizePlan *plan, int threadsHint) {
+    ContextResizeTask task;
+
+    if (!ctx || !source || !dest || !u8ChannelsSupported(source->channels) ||
+        source->channels != dest->channels ||
+        dest->stride < dest->width * dest->channels ||
+        !planMatches(plan, source->width, source->height, dest->width, dest->height))
+        return -1;
+
+    memset(&task, 0, sizeof(task));
+    task.ctx = ctx;
+    task.plan = plan;
+    task.sourceU8 = source;
+    task.destU8 = dest;
+    workerPoolRun(ctx->pool, contextResizeWorker, &task, contextWorkers(ctx, plan, threadsHint));
+    return task.failed ? -1 : 0;
+}
+
+#endif /* HAVE_PTHREADS */
+
+/* ============================================================================
+ * TILED RESIZE & NUMA
+ * ============================================================================
+ * Tujuan dibagi tile tileWidth x tileHeight yang dinomori row-major; tiap
+ * worker memegang satu rentang tile berurutan, jadi halaman dest pertama
+ * kali disentuh (first-touch) oleh worker pinned yang menghitungnya dan
+ * tetap lokal di node-nya. Per tile kernel memakai sub-plan jendela kolom
+ * (pointer tabel digeser x0), row cache cukup selebar tile.
+ *
+ * Sumber bisa di-interleave antar node NUMA (mbind) atau direplikasi per
+ * node; worker membaca replika node tempat ia berjalan (getcpu). Tanpa
+ * syscall NUMA semuanya jatuh ke sumber bersama.
+ */
+
+#ifdef HAVE_PTHREADS
+
+#define DEFAULT_TILE_WIDTH  256
+#define DEFAULT_TILE_HEIGHT 64
+#define MAX_NUMA_NODES      64
+#define NUMA_PAGE_SIZE      4096
+
+/* 0 = default */
+typedef struct {
+    int tileWidth;
+    int tileHeight;
+} ResizeTiling;
+
+typedef enum {
+    NUMA_SOURCE_SHARED,         /* pakai buffer apa adanya */
+    NUMA_SOURCE_INTERLEAVE,     /* halaman sumber disebar round-robin antar node */
+    NUMA_SOURCE_REPLICATE       /* satu salinan sumber per node */
+} NumaSourcePolicy;
+
+typedef struct {
+    const void *data;           /* buffer asli (source->data) */
+    size_t bytes;
+    void *replicas[MAX_NUMA_NODES];  /* NULL = pakai data */
+    NumaSourcePolicy policy;    /* policy yang benar-benar berlaku */
+} NumaSource;
+
+/* Bitmask node online dari sysfs; return jumlah node (min 1) */
+static int numaOnlineNodes(unsigned long *mask) {
+    FILE *f = fopen("/sys/devices/system/node/online", "r");
+    int a, b, count = 0;
+    char sep;
+
+    *mask = 1;
+    if (!f) return 1;
+
+    *mask = 0;
+    while (fscanf(f, "%d", &a) == 1) {
+        b = a;
+        if (fscanf(f, "%c", &sep) == 1 && sep == '-') {
+            if (fscanf(f, "%d", &b) != 1) break;
+            if (fscanf(f, "%c", &sep) != 1) sep = '\n';
+        }
+        for (; a <= b && a < MAX_NUMA_NODES; a++) {
+            *mask |= 1UL << a;
+            count++;
+        }
+        if (sep != ',') break;
+    }
+    fclose(f);
+
+    if (count == 0) {
+        *mask = 1;
+        return 1;
+    }
+    return count;
+}
+
+static int currentNumaNode(void) {
+#ifdef HAVE_NUMA_SYSCALLS
+    unsigned cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0 && node < MAX_NUMA_NODES)
+        return (int)node;
+#endif
+    return 0;
+}
+
+#ifdef HAVE_NUMA_SYSCALLS
+#define NUMA_MPOL_BIND        2
+#define NUMA_MPOL_INTERLEAVE  3
+#define NUMA_MPOL_MF_MOVE     (1 << 1)
+
+/* mbind pada rentang yang dibulatkan ke batas halaman */
+static int numaBind(const void *addr, size_t bytes, int mode, unsigned long mask,
+                    unsigned flags) {
+    uintptr_t start = (uintptr_t)addr & ~(uintptr_t)(NUMA_PAGE_SIZE - 1);
+    uintptr_t end = ((uintptr_t)addr + bytes + NUMA_PAGE_SIZE - 1) & ~(uintptr_t)(NUMA_PAGE_SIZE - 1);
+
+    return syscall(SYS_mbind, (void*)start, (unsigned long)(end - start), mode,
+                   &mask, (unsigned long)(8 * sizeof(mask) + 1), flags) == 0 ? 0 : -1;
+}
+#endif
+
+void freeNumaSource(NumaSource *numa) {
+    int n;
+
+    if (!numa) return;
+    for (n = 0; n < MAX_NUMA_NODES; n++) free(numa->replicas[n]);
+    free(numa);
+}
+
+/* Siapkan sumber (data, bytes) untuk policy; jika kernel/mesin tidak
+ * mendukung (satu node, tanpa mbind) policy turun ke SHARED. Interleave
+ * mengubah memory policy buffer pemanggil secara permanen. */
+NumaSource* createNumaSource(const void *data, size_t bytes, NumaSourcePolicy policy) {
+    NumaSource *numa = (NumaSource*)calloc(1, sizeof(NumaSource));
+    unsigned long mask;
+    int numNodes;
+
+    if (!numa) return NULL;
+    numa->data = data;
+    numa->bytes = bytes;
+    numa->policy = NUMA_SOURCE_SHARED;
+
+    numNodes = numaOnlineNodes(&mask);
+    if (numNodes <= 1 || policy == NUMA_SOURCE_SHARED) return numa;
+
+#ifdef HAVE_NUMA_SYSCALLS
+    if (policy == NUMA_SOURCE_INTERLEAVE) {
+        if (numaBind(data, bytes, NUMA_MPOL_INTERLEAVE, mask, NUMA_MPOL_MF_MOVE) == 0)
+            numa->policy = NUMA_SOURCE_INTERLEAVE;
+    } else {
+        int n;
+
+        /* Bind dulu baru salin: halaman dialokasikan di node n berapa pun
+         * CPU yang menyalin */
+        for (n = 0; n < MAX_NUMA_NODES; n++) {
+            void *copy;
+
+            if (!(mask & (1UL << n))) continue;
+            if (posix_memalign(&copy, NUMA_PAGE_SIZE, bytes) != 0) break;
+            if (numaBind(copy, bytes, NUMA_MPOL_BIND, 1UL << n, 0) != 0) {
+                free(copy);
+                break;
+            }
+            memcpy(copy, data, bytes);
+            numa->replicas[n] = copy;
+        }
+        if (n == MAX_NUMA_NODES) {
+            numa->policy = NUMA_SOURCE_REPLICATE;
+        } else {
+            for (n = 0; n < MAX_NUMA_NODES; n++) {
+                free(numa->replicas[n]);
+                numa->replicas[n] = NULL;
+            }
+        }
+    }
+#endif
+    return numa;
+}
+
+/* Data sumber untuk node tempat thread ini berjalan */
+static const void* numaLocalData(const NumaSource *numa) {
+    const void *local = NULL;
+
+    if (numa->policy == NUMA_SOURCE_REPLICATE)
+        local = numa->replicas[currentNumaNode()];
+    return local ? local : numa->data;
+}
+
+typedef struct {
+    ResizeContext *ctx;
+    const ResizePlan *plan;
+    const NumaSource *numa;
+    const Image *source;
+    Image *dest;
+    const ImageU8 *sourceU8;
+    ImageU8 *destU8;
+    int tileWidth, tileHeight;
+    int tilesX, numTiles;
+    int failed;
+} TiledResizeTask;
+
+static void tiledResizeWorker(void *arg, int worker, int numWorkers) {
+    TiledResizeTask *t = (TiledResizeTask*)arg;
+    int first = (int)((long)t->numTiles * worker / numWorkers);
+    int last = (int)((long)t->numTiles * (worker + 1) / numWorkers);
+    int channels = t->source ? 3 : t->sourceU8->channels;
+    size_t lanes = (size_t)channels * t->tileWidth;
+    size_t laneBytes = t->source ? sizeof(float) : sizeof(int16_t);
+    Image srcView;
+    ImageU8 srcViewU8;
+    RowCache cache;
+    RowCacheU8 cacheU8;
+    int tile;
+
+    if (first >= last) return;
+
+    cache.rows[0] = (float*)contextScratch(t->ctx, worker, 2 * lanes * laneBytes);
+    if (!cache.rows[0]) {
+        __atomic_store_n(&t->failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    cache.rows[1] = cache.rows[0] + lanes;
+    cacheU8.rows[0] = (int16_t*)cache.rows[0];
+    cacheU8.rows[1] = cacheU8.rows[0] + lanes;
+
+    memset(&srcView, 0, sizeof(srcView));
+    memset(&srcViewU8, 0, sizeof(srcViewU8));
+    if (t->source) {
+        srcView = *t->source;
+        if (t->numa) srcView.data = (Pixel*)numaLocalData(t->numa);
+    } else {
+        srcViewU8 = *t->sourceU8;
+        if (t->numa) srcViewU8.data = (uint8_t*)numaLocalData(t->numa);
+    }
+
+    for (tile = first; tile < last; tile++) {
+        int x0 = (tile % t->tilesX) * t->tileWidth;
+        int y0 = (tile / t->tilesX) * t->tileHeight;
+        int y1 = mini(y0 + t->tileHeight, t->plan->dstHeight);
+        ResizePlan sub = planColumnWindow(t->plan, x0, mini(t->tileWidth, t->plan->dstWidth - x0));
+        int y;
+
+        cache.srcY[0] = cache.srcY[1] = -1;
+        cacheU8.srcY[0] = cacheU8.srcY[1] = -1;
+
+        for (y = y0; y < y1; y++) {
+            if (t->source) {
+                resizeRowCached(&srcView, &sub, t->ctx->kernels, &cache,
+                                t->dest->data + (size_t)y * t->dest->stride + x0, y);
+            } else {
+                resizeRowU8(&srcViewU8, &sub, &cacheU8,
+                            t->destU8->data + (size_t)y * t->destU8->stride + (size_t)channels * x0, y);
+            }
+        }
+    }
+}
+
+static void runTiled(TiledResizeTask *task, const ResizeTiling *tiling, int threadsHint) {
+    const ResizePlan *plan = task->plan;
+    int tilesY, workers;
+
+    task->tileWidth = (tiling && tiling->tileWidth > 0) ? tiling->tileWidth : DEFAULT_TILE_WIDTH;
+    task->tileHeight = (tiling && tiling->tileHeight > 0) ? tiling->tileHeight : DEFAULT_TILE_HEIGHT;
+    task->tileWidth = mini(task->tileWidth, plan->dstWidth);
+    task->tileHeight = mini(task->tileHeight, plan->dstHeight);
+    task->tilesX = (plan->dstWidth + task->tileWidth - 1) / task->tileWidth;
+    tilesY = (plan->dstHeight + task->tileHeight - 1) / task->tileHeight;
+    task->numTiles = task->tilesX * tilesY;
+
+    workers = (threadsHint > 0) ? threadsHint : task->ctx->pool->size;
+    if (workers > task->numTiles) workers = task->numTiles;
+    workerPoolRun(task->ctx->pool, tiledResizeWorker, task, workers);
+}
+
+/* Resize tiled ke dest. tiling/numa boleh NULL (default / sumber bersama);
+ * numa harus dibuat dari source->data. Return 0 sukses, -1 gagal. */
+int resizeTiledInto(ResizeContext *ctx, const Image *source, Image *dest,
+                    const ResizePlan *plan, const ResizeTiling *tiling,
+                    const NumaSource *numa, int threadsHint) {
+    TiledResizeTask task;
+
+    if (!ctx || !source || !dest || dest->stride < dest->width ||
+        (numa && numa->data != source->data) ||
+        !planMatches(plan, source->width, source->height, dest->width, dest->height))
+        return -1;
+
+    memset(&task, 0, sizeof(task));
+    task.ctx = ctx;
+    task.plan = plan;
+    task.numa = numa;
+    task.source = source;
+    task.dest = dest;
+    runTiled(&task, tiling, threadsHint);
+    return task.failed ? -1 : 0;
+}
+
+int resizeTiledU8Into(ResizeContext *ctx, const ImageU8 *source, ImageU8 *dest,
+                      const ResizePlan *plan, const ResizeTiling *tiling,
+                      const NumaSource *numa, int threadsHint) {
+    TiledResizeTask task;
+
+    if (!ctx || !source || !dest || !u8ChannelsSupported(source->channels) ||
+        source->channels != dest->channels ||
+        dest->stride < dest->width * dest->channels ||
+        (numa && numa->data != source->data) ||
+        !planMatches(plan, source->width, source->height, dest->width, dest->height))
+        return -1;
+
+    memset(&task, 0, sizeof(task));
+    task.ctx = ctx;
+    task.plan = plan;
+    task.numa = numa;
+    task.sourceU8 = source;
+    task.destU8 = dest;
+    runTiled(&task, tiling, threadsHint);
+    return task.failed ? -1 : 0;
+}
+
+/* Alokasi dest baru di luar pool tanpa zero-fill (halaman belum disentuh
+ * untuk image besar), lalu worker yang first-touch tile miliknya. Buffer
+ * dari pool tidak dipakai karena halamannya sudah di node pemakai lama. */
+Image* resizeTiled(ResizeContext *ctx, const Image *source, const ResizePlan *plan,
+                   const ResizeTiling *tiling, const NumaSource *numa, int threadsHint) {
+    Image *dest;
+
+    if (!plan) return NULL;
+    dest = createImageBuffer(plan->dstWidth, plan->dstHeight, 1);
+    if (!dest) return NULL;
+
+    if (resizeTiledInto(ctx, source, dest, plan, tiling, numa, threadsHint) != 0) {
+        freeImage(dest);
+        return NULL;
+    }
+    return dest;
+}
+
+#endif /* HAVE_PTHREADS */
+
+/* ============================================================================
+ * CREATE TEST IMAGE
+ * ============================================================================ */
+
+Image* createTestImage(int size) {
+    Image *img;
+    int x, y;
+
+    img = createImage(size, size);
+    if (!img) return NULL;
+
+    /* Isi dengan gradient pattern */
+    for (y = 0; y < size; y++) {
+        for (x = 0; x < size; x++) {
+            float val = (float)((x + y) % 256);
+            Pixel p;
+            p.r = val;
+            p.g = val;
+            p.b = val;
+            setPixel(img, x, y, p);
+        }
+    }
+
+    return img;
+}
+
+ImageU8* createTestImageU8(int size, int channels) {
+    ImageU8 *img;
+    int x, y, c;
+
+    img = createImageU8(size, size, channels);
+    if (!img) return NULL;
+
+    /* Gradient pattern yang sama dengan createTestImage */
+    for (y = 0; y < size; y++) {
+        for (x = 0; x < size; x++) {
+            for (c = 0; c < channels; c++) {
+                img->data[(size_t)y * img->stride + x * channels + c] = (uint8_t)((x + y) % 256);
+            }
+        }
+    }
+
+    return img;
+}
+
+/* Selisih maksimum path 8-bit vs path float (channel r/g/b) */
+int maxImageU8Diff(const Image *ref, const ImageU8 *img) {
+    int maxDiff = 0;
+    int x, y, c;
+
+    if (!ref || !img || ref->width != img->width || ref->height != img->height) return -1;
+
+    for (y = 0; y < img->height; y++) {
+        for (x = 0; x < img->width; x++) {
+            const Pixel *p = &ref->data[(size_t)y * ref->stride + x];
+            const uint8_t *q = img->data + (size_t)y * img->stride + x * img->channels;
+            float v[3];
+            v[0] = p->r; v[1] = p->g; v[2] = p->b;
+            for (c = 0; c < img->channels && c < 3; c++) {
+                int d = abs((int)lrintf(v[c]) - (int)q[c]);
+                if (d > maxDiff) maxDiff = d;
+            }
+        }
+    }
+    return maxDiff;
+}
+
+/* Waktu wall-clock monotonic dalam ms (bukan clock(), yang menjumlah CPU
+ * time semua thread sehingga speedup OpenMP tidak terlihat) */
+double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1.0e6;
+}
+
+/* ============================================================================
+ * KONVERSI FLOAT <-> 8-BIT
+ * ============================================================================ */
+
+/* Image float dari ImageU8; gray -> r=g=b, alpha diabaikan */
+Image* imageFromU8(const ImageU8 *src) {
+    Image *img = createImageUninit(src->width, src->height);
+    int x, y;
+
+    if (!img) return NULL;
+
+    for (y = 0; y < src->height; y++) {
+        const uint8_t *in = src->data + (size_t)y * src->stride;
+        Pixel *out = img->data + (size_t)y * img->stride;
+
+        for (x = 0; x < src->width; x++) {
+            const uint8_t *p = in + x * src->channels;
+            out[x].r = p[0];
+            out[x].g = (src->channels >= 3) ? p[1] : p[0];
+            out[x].b = (src->channels >= 3) ? p[2] : p[0];
+        }
+    }
+    return img;
+}
+
+static uint8_t toU8(float v) {
+    if (v <= 0.0f) return 0;
+    if (v >= 255.0f) return 255;
+    return (uint8_t)(v + 0.5f);
+}
+
+/* Tulis Image float ke dest 8-bit (ukuran sama); gray = luma Rec.601,
+ * alpha = 255. Return 0 sukses, -1 jika ukuran beda. */
+int imageToU8(const Image *src, ImageU8 *dest) {
+    int x, y;
+
+    if (src->width != dest->width || src->height != dest->height) return -1;
+
+    for (y = 0; y < src->height; y++) {
+        const Pixel *in = src->data + (size_t)y * src->stride;
+        uint8_t *out = dest->data + (size_t)y * dest->stride;
+
+        for (x = 0; x < src->width; x++) {
+            uint8_t *p = out + x * dest->channels;
+            if (dest->channels == 1) {
+                p[0] = toU8(0.299f * in[x].r + 0.587f * in[x].g + 0.114f * in[x].b);
+            } else {
+                p[0] = toU8(in[x].r);
+                p[1] = toU8(in[x].g);
+                p[2] = toU8(in[x].b);
+                if (dest->channels == 4) p[3] = 255;
+            }
+        }
+    }
+    return 0;
+}
+
+/* ============================================================================
+ * IMAGE I/O (mmap PPM / PGM / RAW)
+ * ============================================================================
+ * File input di-mmap read-only; ImageU8.data menunjuk langsung ke data
+ * pixel di page cache (zero-copy), jadi kernel 8-bit membaca tanpa salinan.
+ * File output dibuat dengan ukuran final (ftruncate) lalu di-mmap shared,
+ * sehingga resize menulis langsung ke file.
+ * Format: P5 (PGM, 1 channel) / P6 (PPM, 3 channel) maxval <= 255, dan
+ * raw tanpa header (ukuran & channel dari caller). Bilinear tidak keluar
+ * dari rentang [0, maxval], jadi maxval input ditulis apa adanya ke header
+ * output (tanpa rescale ke 255).
+ */
+
+typedef enum {
+    IMAGE_FILE_RAW,
+    IMAGE_FILE_PGM,
+    IMAGE_FILE_PPM
+} ImageFileFormat;
+
+typedef struct {
+    ImageU8 image;      /* view ke mapping */
+    void *base;
+    size_t length;
+    int writable;
+    int maxval;         /* nilai putih PNM; 255 untuk raw */
+} MappedImage;
+
+/* Tebak format dari ekstensi file (.ppm/.pgm, selain itu raw) */
+ImageFileFormat imageFormatFromPath(const char *path) {
+    const char *dot = strrchr(path, '.');
+
+    if (dot && (strcmp(dot, ".ppm") == 0 || strcmp(dot, ".PPM") == 0)) return IMAGE_FILE_PPM;
+    if (dot && (strcmp(dot, ".pgm") == 0 || strcmp(dot, ".PGM") == 0)) return IMAGE_FILE_PGM;
+    return IMAGE_FILE_RAW;
+}
+
+#ifdef HAVE_MMAP_IO
+/* Baca 1 angka header PNM (lewati whitespace dan komentar '#');
+ * return -1 jika tidak valid */
+static long readPnmNumber(const unsigned char *data, size_t length, size_t *pos) {
+    long value = 0;
+    int digits = 0;
+
+    while (*pos < length) {
+        if (data[*pos] == '#') {
+            while (*pos < length && data[*pos] != '\n') (*pos)++;
+        } else if (data[*pos] == ' ' || data[*pos] == '\t' ||
+                   data[*pos] == '\n' || data[*pos] == '\r') {
+            (*pos)++;
+        } else {
+            break;
+        }
+    }
+    while (*pos < length && data[*pos] >= '0' && data[*pos] <= '9' && value < 100000000L) {
+        value = value * 10 + (data[*pos] - '0');
+        (*pos)++;
+        digits++;
+    }
+    return digits ? value : -1;
+}
+
+static MappedImage* mapFile(const char *path, int writable, size_t length) {
+    MappedImage *img;
+    struct stat st;
+    int fd;
+
+    fd = writable ? open(path, O_RDWR | O_CREAT | O_TRUNC, 0644) : open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    if (writable) {
+        if (ftruncate(fd, (off_t)length) != 0) {
+            close(fd);
+            return NULL;
+        }
+    } else {
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            return NULL;
+        }
+        length = (size_t)st.st_size;
+    }
+
+    img = (MappedImage*)calloc(1, sizeof(MappedImage));
+    if (!img) {
+        close(fd);
+        return NULL;
+    }
+
+    img->base = mmap(NULL, length, writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                     writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (img->base == MAP_FAILED) {
+        free(img);
+        return NULL;
+    }
+
+    img->length = length;
+    img->writable = writable;
+    posix_madvise(img->base, length, POSIX_MADV_SEQUENTIAL);
+    return img;
+}
+
+int closeMappedImage(MappedImage *img) {
+    int status = 0;
+
+    if (!img) return 0;
+    if (img->writable && msync(img->base, img->length, MS_SYNC) != 0) status = -1;
+    if (munmap(img->base, img->length) != 0) status = -1;
+    free(img);
+    return status;
+}
+
+/* Buka PPM (P6) / PGM (P5) binary 8-bit; NULL jika gagal atau format lain */
+MappedImage* openMappedImage(const char *path) {
+    MappedImage *img = mapFile(path, 0, 0);
+    const unsigned char *data;
+    long width, height, maxval;
+    size_t pos = 2;
+    int channels;
+
+    if (!img) return NULL;
+    data = (const unsigned char*)img->base;
+
+    if (img->length < 2 || data[0] != 'P' || (data[1] != '5' && data[1] != '6')) {
+        closeMappedImage(img);
+        return NULL;
+    }
+    channels = (data[1] == '6') ? 3 : 1;
+
+    width = readPnmNumber(data, img->length, &pos);
+    height = readPnmNumber(data, img->length, &pos);
+    maxval = readPnmNumber(data, img->length, &pos);
+    pos++;  /* satu whitespace setelah maxval */
+
+    if (width <= 0 || height <= 0 || maxval <= 0 || maxval > 255 ||
+        pos + (size_t)width * height * channels > img->length) {
+        closeMappedImage(img);
+        return NULL;
+    }
+
+    img->image = imageU8View((uint8_t*)img->base + pos, (int)width, (int)height,
+                             channels, (int)width * channels);
+    img->maxval = (int)maxval;
+    return img;
+}
+
+/* Buka file raw tanpa header dengan ukuran yang diketahui */
+MappedImage* openMappedRaw(const char *path, int width, int height, int channels) {
+    MappedImage *img = mapFile(path, 0, 0);
+
+    if (!img) return NULL;
+    if (width <= 0 || height <= 0 || !u8ChannelsSupported(channels) ||
+        (size_t)width * height * channels > img->length) {
+        closeMappedImage(img);
+        return NULL;
+    }
+
+    img->image = imageU8View((uint8_t*)img->base, width, height, channels, width * channels);
+    img->maxval = 255;
+    return img;
+}
+
+/* Buat file output berukuran final dan mmap; PPM wajib 3 channel, PGM 1.
+ * maxval (1..255) ditulis ke header PNM, diabaikan untuk raw. */
+MappedImage* createMappedImage(const char *path, ImageFileFormat format,
+                               int width, int height, int channels, int maxval) {
+    char header[64];
+    size_t headerLength = 0;
+    MappedImage *img;
+
+    if (width <= 0 || height <= 0 || !u8ChannelsSupported(channels) ||
+        maxval <= 0 || maxval > 255)
+        return NULL;
+    if ((format == IMAGE_FILE_PPM && channels != 3) ||
+        (format == IMAGE_FILE_PGM && channels != 1))
+        return NULL;
+
+    if (format != IMAGE_FILE_RAW) {
+        headerLength = (size_t)snprintf(header, sizeof(header), "P%c\n%d %d\n%d\n",
+                                        format == IMAGE_FILE_PPM ? '6' : '5', width, height,
+                                        maxval);
+    }
+
+    img = mapFile(path, 1, headerLength + (size_t)width * height * channels);
+    if (!img) return NULL;
+
+    memcpy(img->base, header, headerLength);
+    img->image = imageU8View((uint8_t*)img->base + headerLength, width, height,
+                             channels, width * channels);
+    img->maxval = maxval;
+    return img;
+}
+
+/* --resize IN OUT WxH: input mmap -> kernel 8-bit -> output mmap.
+ * Input raw butuh --raw-size WxHxC. Return exit code. */
+int runResizeFile(const char *inputPath, const char *outputPath, int dstWidth, int dstHeight,
+                  int rawWidth, int rawHeight, int rawChannels, int numThreads) {
+    MappedImage *input, *output;
+    ResizePlan *plan;
+    ImageFileFormat outFormat = imageFormatFromPath(outputPath);
+    struct stat inStat, outStat;
+    double start, elapsed;
+    int status;
+
+    /* Output dibuat dengan O_TRUNC: file yang sama akan memotong mapping
+     * input di tengah resize (SIGBUS) */
+    if (stat(inputPath, &inStat) == 0 && stat(outputPath, &outStat) == 0 &&
+        inStat.st_dev == outStat.st_dev && inStat.st_ino == outStat.st_ino) {
+        fprintf(stderr, "Error: %s and %s are the same file\n", inputPath, outputPath);
+        return 1;
+    }
+
+    if (imageFormatFromPath(inputPath) == IMAGE_FILE_RAW)
+        input = openMappedRaw(inputPath, rawWidth, rawHeight, rawChannels);
+    else
+        input = openMappedImage(inputPath);
+    if (!input) {
+        fprintf(stderr, "Error: cannot read %s (binary PPM/PGM 8-bit, or raw with --raw-size)\n",
+                inputPath);
+        return 1;
+    }
+
+    output = createMappedImage(outputPath, outFormat, dstWidth, dstHeight,
+                               input->image.channels, input->maxval);
+    plan = createResizePlan(input->image.width, input->image.height, dstWidth, dstHeight);
+    if (!output || !plan) {
+        fprintf(stderr, "Error: cannot create %s (%d channel(s) %s)\n", outputPath,
+                input->image.channels,
+                outFormat == IMAGE_FILE_PPM ? "as PPM" : outFormat == IMAGE_FILE_PGM ? "as PGM" : "raw");
+        freeResizePlan(plan);
+        closeMappedImage(output);
+        closeMappedImage(input);
+        return 1;
+    }
+
+    start = nowMs();
+    status = resizeU8Into(&input->image, &output->image, plan, numThreads);
+    elapsed = nowMs() - start;
+
+    printf("%s (%dx%d, %d ch) -> %s (%dx%d): %.3f ms\n", inputPath,
+           input->image.width, input->image.height, input->image.channels,
+           outputPath, dstWidth, dstHeight, elapsed);
+
+    freeResizePlan(plan);
+    if (closeMappedImage(output) != 0) status = -1;
+    closeMappedImage(input);
+    return status == 0 ? 0 : 1;
+}
+#endif
+
+/* Selisih absolut maksimum per channel; -1 jika ukuran tidak cocok */
+double maxImageDiff(const Image *a, const Image *b) {
+    double maxDiff = 0.0;
+    int x, y;
+
+    if (!a || !b || a->width != b->width || a->height != b->height) return -1.0;
+
+    for (y = 0; y < a->height; y++) {
+        for (x = 0; x < a->width; x++) {
+            Pixel p = getPixel(a, x, y);
+            Pixel q = getPixel(b, x, y);
+            double dr = fabs(p.r - q.r);
+            double dg = fabs(p.g - q.g);
+            double db = fabs(p.b - q.b);
+            if (dr > maxDiff) maxDiff = dr;
+            if (dg > maxDiff) maxDiff = dg;
+            if (db > maxDiff) maxDiff = db;
+        }
+    }
+    return maxDiff;
+}
+
+/* ============================================================================
+ * FRAME PIPELINE (baca, resize, tulis secara overlap)
+ * ============================================================================
+ * Untuk deretan frame (video / image sequence). Thread reader memanggil
+ * producer, caller me-resize, thread writer memanggil consumer. Ring
+ * berisi depth slot (image sumber + tujuan) yang dialokasi sekali di awal,
+ * dan setiap slot berputar FREE -> LOADED -> RESIZED -> FREE. Dengan
+ * depth >= 3, frame N+1 dibaca saat frame N di-resize dan frame N-1
+ * ditulis. Throughput mendekati tahap paling lambat, bukan jumlah ketiganya.
+ * Steady state tanpa alokasi: plan, slot, thread dan row cache per thread
+ * resize (atau scratch ctx) dibuat sekali per run.
+ */
+
+#ifdef HAVE_PTHREADS
+
+#define DEFAULT_PIPELINE_DEPTH 3
+
+/* Isi frame (srcWidth x srcHeight) dengan frame ke-index.
+ * Return 1 = frame terisi, 0 = stream habis, -1 = error */
+typedef int (*FrameProducer)(void *userData, long index, Image *frame);
+
+/* Terima hasil frame ke-index (valid selama callback, lalu slot dipakai
+ * ulang). Return 0 lanjut, selain itu = error, pipeline dihentikan */
+typedef int (*FrameConsumer)(void *userData, long index, const Image *frame);
+
+typedef struct {
+    int srcWidth, srcHeight;
+    int dstWidth, dstHeight;
+    int depth;              /* jumlah slot ring, <= 0 = DEFAULT_PIPELINE_DEPTH */
+    int threads;            /* thread resize per frame */
+    ResizeContext *ctx;     /* opsional: pool persisten, NULL = OpenMP + fast path rasio */
+} FramePipelineConfig;
+
+/* Waktu kumulatif per tahap; wallMs < readMs + resizeMs + writeMs = overlap */
+typedef struct {
+    long frames;
+    double readMs, resizeMs, writeMs;
+    double wallMs;
+} FramePipelineStats;
+
+typedef enum { SLOT_FREE, SLOT_LOADED, SLOT_RESIZED } FrameSlotState;
+
+typedef struct {
+    Image *source;
+    Image *dest;
+    FrameSlotState state;
+} FrameSlot;
+
+typedef struct {
+    FrameProducer producer;
+    FrameConsumer consumer;
+    void *userData;
+    FrameSlot *slots;
+    int depth;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    long total;             /* jumlah frame stream, -1 selama producer belum habis */
+    long written;
+    int failed;
+    double readMs, writeMs;
+} FramePipeline;
+
+/* Frame index ada di slot index % depth; slot baru FREE setelah frame
+ * index - depth ditulis, jadi state slot selalu milik frame yang ditunggu.
+ * Dipanggil dengan lock; return 0 jika slot mencapai state, -1 jika
+ * pipeline gagal atau index sudah melewati akhir stream. */
+static int pipelineWait(FramePipeline *p, long index, FrameSlotState state) {
+    FrameSlot *slot = &p->slots[index % p->depth];
+
+    for (;;) {
+        if (p->failed) return -1;
+        if (slot->state == state) return 0;
+        if (state != SLOT_FREE && p->total >= 0 && index >= p->total) return -1;
+        pthread_cond_wait(&p->changed, &p->lock);
+    }
+}
+
+static void* pipelineReader(void *arg) {
+    FramePipeline *p = (FramePipeline*)arg;
+    long i;
+
+    for (i = 0; ; i++) {
+        FrameSlot *slot = &p->slots[i % p->depth];
+        double start;
+        int status;
+
+        pthread_mutex_lock(&p->lock);
+        status = pipelineWait(p, i, SLOT_FREE);
+        pthread_mutex_unlock(&p->lock);
+        if (status != 0) break;
+
+        start = nowMs();
+        status = p->producer(p->userData, i, slot->source);
+
+        pthread_mutex_lock(&p->lock);
+        p->readMs += nowMs() - start;
+        if (status == 1) slot->state = SLOT_LOADED;
+        else if (status == 0) p->total = i;
+        else p->failed = 1;
+        pthread_cond_broadcast(&p->changed);
+        pthread_mutex_unlock(&p->lock);
+        if (status != 1) break;
+    }
+    return NULL;
+}
+
+static void* pipelineWriter(void *arg) {
+    FramePipeline *p = (FramePipeline*)arg;
+    long i;
+
+    for (i = 0; ; i++) {
+        FrameSlot *slot = &p->slots[i % p->depth];
+        double start;
+        int status;
+
+        pthread_mutex_lock(&p->lock);
+        status = pipelineWait(p, i, SLOT_RESIZED);
+        pthread_mutex_unlock(&p->lock);
+        if (status != 0) break;
+
+        start = nowMs();
+        status = p->consumer(p->userData, i, slot->dest);
+
+        pthread_mutex_lock(&p->lock);
+        p->writeMs += nowMs() - start;
+        if (status == 0) {
+            slot->state = SLOT_FREE;
+            p->written++;
+        } else {
+            p->failed = 1;
+        }
+        pthread_cond_broadcast(&p->changed);
+        pthread_mutex_unlock(&p->lock);
+        if (status != 0) break;
+    }
+    return NULL;
+}
+
+/* Jalankan pipeline sampai producer habis. Resize berjalan di thread caller
+ * (OpenMP / pool ctx dengan cfg->threads), reader & writer di 2 thread
+ * sendiri. Return jumlah frame yang ditulis, -1 jika producer, consumer,
+ * resize atau alokasi gagal. stats boleh NULL. */
+long resizeFramePipeline(const FramePipelineConfig *cfg, FrameProducer producer,
+                         FrameConsumer consumer, void *userData, FramePipelineStats *stats) {
+    FramePipeline p;
+    const ResizePlan *plan;
+    RowCache *caches = NULL;
+    pthread_t reader, writer;
+    int readerStarted = 0, writerStarted = 0;
+    int numCaches = 0;
+    double start = nowMs(), resizeMs = 0.0;
+    long i, result;
+
+    if (!cfg || !producer || !consumer || cfg->dstWidth <= 0 || cfg->dstHeight <= 0)
+        return -1;
+
+    memset(&p, 0, sizeof(p));
+    p.producer = producer;
+    p.consumer = consumer;
+    p.userData = userData;
+    p.depth = cfg->depth > 0 ? cfg->depth : DEFAULT_PIPELINE_DEPTH;
+    p.total = -1;
+
+    plan = acquireResizePlan(cfg->srcWidth, cfg->srcHeight, cfg->dstWidth, cfg->dstHeight);
+    p.slots = (FrameSlot*)calloc(p.depth, sizeof(FrameSlot));
+    if (!plan || !p.slots) {
+        releaseResizePlan(plan);
+        free(p.slots);
+        return -1;
+    }
+    for (i = 0; i < p.depth; i++) {
+        p.slots[i].source = createImageUninit(cfg->srcWidth, cfg->srcHeight);
+        p.slots[i].dest = createImageUninit(cfg->dstWidth, cfg->dstHeight);
+        if (!p.slots[i].source || !p.slots[i].dest) p.failed = 1;
+    }
+
+    /* Tanpa ctx: row cache per thread resize, dipakai ulang setiap frame */
+    if (!cfg->ctx) {
+        int want = cfg->threads > 1 ? cfg->threads : 1;
+
+        caches = (RowCache*)calloc(want, sizeof(RowCache));
+        if (!caches) p.failed = 1;
+        for (; caches && numCaches < want; numCaches++) {
+            if (initRowCache(&caches[numCaches], 3 * cfg->dstWidth) != 0) {
+                p.failed = 1;
+                break;
+            }
+        }
+    }
+
+    pthread_mutex_init(&p.lock, NULL);
+    pthread_cond_init(&p.changed, NULL);
+
+    if (!p.failed) {
+        readerStarted = pthread_create(&reader, NULL, pipelineReader, &p) == 0;
+        writerStarted = readerStarted &&
+                        pthread_create(&writer, NULL, pipelineWriter, &p) == 0;
+        if (!writerStarted) {
+            pthread_mutex_lock(&p.lock);
+            p.failed = 1;
+            pthread_cond_broadcast(&p.changed);
+            pthread_mutex_unlock(&p.lock);
+        }
+    }
+
+    /* Tahap resize: frame i menunggu LOADED, hasil ditandai RESIZED */
+    for (i = 0; writerStarted; i++) {
+        FrameSlot *slot = &p.slots[i % p.depth];
+        double t0;
+        int status;
+
+        pthread_mutex_lock(&p.lock);
+        status = pipelineWait(&p, i, SLOT_LOADED);
+        pthread_mutex_unlock(&p.lock);
+        if (status != 0) break;
+
+        t0 = nowMs();
+        status = cfg->ctx ? resizeContextInto(cfg->ctx, slot->source, slot->dest, plan, cfg->threads)
+                          : resizeRowsAutoCached(slot->source, slot->dest, plan, cfg->threads, caches);
+        resizeMs += nowMs() - t0;
+
+        pthread_mutex_lock(&p.lock);
+        if (status == 0) slot->state = SLOT_RESIZED;
+        else p.failed = 1;
+        pthread_cond_broadcast(&p.changed);
+        pthread_mutex_unlock(&p.lock);
+        if (status != 0) break;
+    }
+
+    if (readerStarted) pthread_join(reader, NULL);
+    if (writerStarted) pthread_join(writer, NULL);
+
+    if (stats) {
+        stats->frames = p.written;
+        stats->readMs = p.readMs;
+        stats->resizeMs = resizeMs;
+        stats->writeMs = p.writeMs;
+        stats->wallMs = nowMs() - start;
+    }
+    result = p.failed ? -1 : p.written;
+
+    pthread_cond_destroy(&p.changed);
+    pthread_mutex_destroy(&p.lock);
+    for (i = 0; i < p.depth; i++) {
+        freeImage(p.slots[i].source);
+        freeImage(p.slots[i].dest);
+    }
+    free(p.slots);
+    for (i = 0; i < numCaches; i++) freeRowCache(&caches[i]);
+    free(caches);
+    releaseResizePlan(plan);
+    return result;
+}
+
+#endif /* HAVE_PTHREADS */
+
+/* ============================================================================
+ * ASYNC RESIZE (submit, poll, wait, callback)
+ * ============================================================================
+ * Untuk server event loop: resizeSubmit langsung kembali dengan handle,
+ * job dijalankan oleh worker internal ResizeExecutor. Caller bisa poll,
+ * wait, atau menerima callback saat selesai. Antrean = heap prioritas
+ * (prioritas tinggi dulu, FIFO untuk prioritas sama).
+ *
+ * Job memakai ResizeJob yang sama dengan resizeBatch, plan dari plan cache
+ * dan buffer dari caller (createImage/pool buffer image), jadi path sync
+ * dan async berbagi semua state. Job dijalankan per band ASYNC_BAND_ROWS
+ * baris tujuan; cancel pada job yang sedang berjalan berlaku di batas band.
+ *
+ * Callback dipanggil di thread worker sebelum state akhir terlihat oleh
+ * poll/wait, jadi wait yang kembali berarti callback sudah selesai.
+ */
+
+#ifdef HAVE_PTHREADS
+
+#define ASYNC_BAND_ROWS 64
+
+typedef enum {
+    ASYNC_QUEUED,
+    ASYNC_RUNNING,
+    ASYNC_DONE,
+    ASYNC_FAILED,
+    ASYNC_CANCELLED
+} AsyncState;
+
+typedef struct AsyncResize AsyncResize;
+typedef struct ResizeExecutor ResizeExecutor;
+
+/* state = ASYNC_DONE, ASYNC_FAILED atau ASYNC_CANCELLED */
+typedef void (*AsyncCallback)(void *userData, AsyncResize *handle, AsyncState state);
+
+struct AsyncResize {
+    ResizeExecutor *executor;
+    ResizeJob job;
+    int priority;
+    int threads;                /* thread OpenMP di dalam job */
+    unsigned long long seq;
+    AsyncCallback callback;
+    void *userData;
+    int state;                  /* AsyncState, dibaca atomik */
+    int cancel;                 /* permintaan cancel (atomik) */
+    int claimed;                /* 1 = sudah diambil worker/cancel (dengan lock) */
+    int refs;                   /* caller + executor (atomik) */
+};
+
+struct ResizeExecutor {
+    pthread_t *threads;
+    int size;
+    int started;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;        /* job baru / shutdown */
+    pthread_cond_t done;        /* ada job mencapai state akhir */
+    AsyncResize **heap;
+    int count, capacity;
+    unsigned long long nextSeq;
+    int shutdown;
+};
+
+static int asyncBefore(const AsyncResize *a, const AsyncResize *b) {
+    return a->priority != b->priority ? a->priority > b->priority : a->seq < b->seq;
+}
+
+/* Dipanggil dengan lock */
+static int asyncPush(ResizeExecutor *ex, AsyncResize *h) {
+    int i;
+
+    if (ex->count == ex->capacity) {
+        int capacity = ex->capacity ? 2 * ex->capacity : 16;
+        AsyncResize **heap = (AsyncResize**)realloc(ex->heap, capacity * sizeof(AsyncResize*));
+
+        if (!heap) return -1;
+        ex->heap = heap;
+        ex->capacity = capacity;
+    }
+
+    for (i = ex->count++; i > 0 && asyncBefore(h, ex->heap[(i - 1) / 2]); i = (i - 1) / 2)
+        ex->heap[i] = ex->heap[(i - 1) / 2];
+    ex->heap[i] = h;
+    return 0;
+}
+
+/* Dipanggil dengan lock, count > 0 */
+static AsyncResize* asyncPop(ResizeExecutor *ex) {
+    AsyncResize *top = ex->heap[0];
+    AsyncResize *last = ex->heap[--ex->count];
+    int i = 0;
+
+    for (;;) {
+        int child = 2 * i + 1;
+
+        if (child >= ex->count) break;
+        if (child + 1 < ex->count && asyncBefore(ex->heap[child + 1], ex->heap[child])) child++;
+        if (!asyncBefore(ex->heap[child], last)) break;
+        ex->heap[i] = ex->heap[child];
+        i = child;
+    }
+    if (ex->count > 0) ex->heap[i] = last;
+    return top;
+}
+
+void releaseAsyncResize(AsyncResize *h) {
+    if (h && __atomic_sub_fetch(&h->refs, 1, __ATOMIC_ACQ_REL) == 0) free(h);
+}
+
+/* Callback lalu publikasikan state akhir; dipanggil oleh pemilik claim */
+static void asyncFinish(AsyncResize *h, AsyncState state) {
+    ResizeExecutor *ex = h->executor;
+
+    h->job.status = (state == ASYNC_DONE) ? 0 : -1;
+    if (h->callback) h->callback(h->userData, h, state);
+
+    pthread_mutex_lock(&ex->lock);
+    __atomic_store_n(&h->state, state, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&ex->done);
+    pthread_mutex_unlock(&ex->lock);
+    releaseAsyncResize(h);
+}
+
+/* Baris tujuan [y0, y0 + rows) dari job. Kolom utuh, jadi fast path plan
+ * tetap berlaku; decimate membaca (n*x, n*y) relatif, view sumber digeser. */
+static int runJobBand(const ResizeJob *job, const ResizePlan *plan, int y0, int rows,
+                      int numThreads) {
+    ResizePlan band = planRowWindow(plan, y0, rows);
+    int skip = (plan->ratio == RATIO_DECIMATE) ? plan->ratioFactor * y0 : 0;
+
+    band.ratio = plan->ratio;
+    band.srcHeight -= skip;
+
+    if (job->source && job->dest) {
+        Image src = imageRegion(job->source, 0, skip, job->source->width,
+                                job->source->height - skip);
+        Image dst = imageRegion(job->dest, 0, y0, job->dest->width, rows);
+
+        return resizeIntoPlan(&src, &dst, &band, numThreads);
+    } else {
+        ImageU8 src = imageU8Region(job->sourceU8, 0, skip, job->sourceU8->width,
+                                    job->sourceU8->height - skip);
+        ImageU8 dst = imageU8Region(job->destU8, 0, y0, job->destU8->width, rows);
+
+        return resizeU8Into(&src, &dst, &band, numThreads);
+    }
+}
+
+static AsyncState runAsyncJob(AsyncResize *h) {
+    const ResizePlan *plan;
+    int srcW, srcH, dstW, dstH, y, status = 0;
+
+    if (__atomic_load_n(&h->cancel, __ATOMIC_ACQUIRE)) return ASYNC_CANCELLED;
+
+    jobGeometry(&h->job, &srcW, &srcH, &dstW, &dstH);
+    plan = acquireResizePlan(srcW, srcH, dstW, dstH);
+    if (!plan) return ASYNC_FAILED;
+
+    for (y = 0; y < dstH && status == 0; y += ASYNC_BAND_ROWS) {
+        if (__atomic_load_n(&h->cancel, __ATOMIC_ACQUIRE)) {
+            releaseResizePlan(plan);
+            return ASYNC_CANCELLED;
+        }
+        status = runJobBand(&h->job, plan, y, mini(ASYNC_BAND_ROWS, dstH - y), h->threads);
+    }
+
+    releaseResizePlan(plan);
+    return status == 0 ? ASYNC_DONE : ASYNC_FAILED;
+}
+
+static void* asyncWorkerMain(void *arg) {
+    ResizeExecutor *ex = (ResizeExecutor*)arg;
+
+    for (;;) {
+        AsyncResize *h = NULL;
+
+        pthread_mutex_lock(&ex->lock);
+        while (!h) {
+            while (ex->count == 0 && !ex->shutdown)
+                pthread_cond_wait(&ex->wake, &ex->lock);
+            if (ex->count == 0) break;
+
+            /* Entri yang sudah di-claim resizeCancel hanya dibuang */
+            h = asyncPop(ex);
+            if (h->claimed) {
+                releaseAsyncResize(h);
+                h = NULL;
+            } else {
+                h->claimed = 1;
+                __atomic_store_n(&h->state, ASYNC_RUNNING, __ATOMIC_RELEASE);
+            }
+        }
+        pthread_mutex_unlock(&ex->lock);
+        if (!h) break;
+
+        asyncFinish(h, runAsyncJob(h));
+    }
+    return NULL;
+}
+
+/* Cancel semua job antrean, tunggu job yang sedang berjalan, lalu join
+ * worker. Handle yang masih dipegang caller tetap valid (state akhir),
+ * tapi jangan wait/submit bersamaan dengan free. */
+void freeResizeExecutor(ResizeExecutor *ex) {
+    int i;
+
+    if (!ex) return;
+
+    pthread_mutex_lock(&ex->lock);
+    ex->shutdown = 1;
+    for (i = 0; i < ex->count; i++)
+        __atomic_store_n(&ex->heap[i]->cancel, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&ex->wake);
+    pthread_mutex_unlock(&ex->lock);
+
+    /* Worker menghabiskan antrean: job ber-flag cancel selesai sebagai
+     * ASYNC_CANCELLED tanpa dijalankan (callback tetap dipanggil) */
+    for (i = 0; i < ex->started; i++) pthread_join(ex->threads[i], NULL);
+
+    pthread_mutex_destroy(&ex->lock);
+    pthread_cond_destroy(&ex->wake);
+    pthread_cond_destroy(&ex->done);
+    free(ex->heap);
+    free(ex->threads);
+    free(ex);
+}
+
+/* numWorkers <= 0 = jumlah CPU online. NULL jika alokasi / thread gagal. */
+ResizeExecutor* createResizeExecutor(int numWorkers) {
+    ResizeExecutor *ex;
+
+    if (numWorkers <= 0) numWorkers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (numWorkers <= 0) numWorkers = 1;
+
+    ex = (ResizeExecutor*)calloc(1, sizeof(ResizeExecutor));
+    if (!ex) return NULL;
+
+    ex->size = numWorkers;
+    ex->threads = (pthread_t*)calloc(numWorkers, sizeof(pthread_t));
+    pthread_mutex_init(&ex->lock, NULL);
+    pthread_cond_init(&ex->wake, NULL);
+    pthread_cond_init(&ex->done, NULL);
+    if (!ex->threads) {
+        freeResizeExecutor(ex);
+        return NULL;
+    }
+
+    for (ex->started = 0; ex->started < numWorkers; ex->started++) {
+        if (pthread_create(&ex->threads[ex->started], NULL, asyncWorkerMain, ex) != 0) {
+            freeResizeExecutor(ex);
+            return NULL;
+        }
+    }
+    return ex;
+}
+
+/* Antrekan *job (disalin; source/dest harus valid sampai job selesai).
+ * priority lebih tinggi dijalankan lebih dulu; numThreads = thread OpenMP
+ * di dalam job (1 = paralel antar job saja). callback boleh NULL.
+ * Return handle (lepas dengan releaseAsyncResize), NULL jika gagal. */
+AsyncResize* resizeSubmit(ResizeExecutor *ex, const ResizeJob *job, int priority,
+                          int numThreads, AsyncCallback callback, void *userData) {
+    AsyncResize *h;
+    int status;
+
+    if (!ex || !job) return NULL;
+
+    h = (AsyncResize*)calloc(1, sizeof(AsyncResize));
+    if (!h) return NULL;
+
+    h->executor = ex;
+    h->job = *job;
+    h->job.status = -1;
+    h->priority = priority;
+    h->threads = numThreads;
+    h->callback = callback;
+    h->userData = userData;
+    h->state = ASYNC_QUEUED;
+    h->refs = 2;
+
+    pthread_mutex_lock(&ex->lock);
+    h->seq = ex->nextSeq++;
+    status = ex->shutdown ? -1 : asyncPush(ex, h);
+    if (status == 0) pthread_cond_signal(&ex->wake);
+    pthread_mutex_unlock(&ex->lock);
+
+    if (status != 0) {
+        free(h);
+        return NULL;
+    }
+    return h;
+}
+
+AsyncState resizePoll(const AsyncResize *h) {
+    return (AsyncState)__atomic_load_n(&h->state, __ATOMIC_ACQUIRE);
+}
+
+/* Blok sampai job mencapai state akhir (callback sudah kembali) */
+AsyncState resizeWait(AsyncResize *h) {
+    ResizeExecutor *ex = h->executor;
+    AsyncState state = resizePoll(h);
+
+    if (state >= ASYNC_DONE) return state;
+
+    pthread_mutex_lock(&ex->lock);
+    while ((state = resizePoll(h)) < ASYNC_DONE)
+        pthread_cond_wait(&ex->done, &ex->lock);
+    pthread_mutex_unlock(&ex->lock);
+    return state;
+}
+
+/* Return 0 = dibatalkan sebelum mulai (dest tidak disentuh, callback
+ * ASYNC_CANCELLED dipanggil di thread ini), 1 = sedang berjalan, berhenti
+ * di batas band berikutnya (dest sebagian), -1 = sudah selesai. */
+int resizeCancel(AsyncResize *h) {
+    ResizeExecutor *ex = h->executor;
+    int queued;
+
+    if (resizePoll(h) >= ASYNC_DONE) return -1;
+
+    pthread_mutex_lock(&ex->lock);
+    queued = !h->claimed;
+    h->claimed = 1;
+    __atomic_store_n(&h->cancel, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&ex->lock);
+
+    if (queued) {
+        /* Entri heap tetap ada (dibuang worker), jadi executor perlu ref sendiri */
+        __atomic_add_fetch(&h->refs, 1, __ATOMIC_ACQ_REL);
+        asyncFinish(h, ASYNC_CANCELLED);
+        return 0;
+    }
+    return resizePoll(h) >= ASYNC_DONE ? -1 : 1;
+}
+
+#endif /* HAVE_PTHREADS */
+
+/* ============================================================================
+ * BENCHMARK FUNCTION
+ * ============================================================================ */
+
+void runBenchmark() {
+    int testSizes[] = {512, 1024, 2048};
+    int numTests = 3;
+    int targetSize = 2048;
+    int t, i;
 
     printf("\n");
     printf("========================================================================\n");
     printf("      BENCHMARK: BILINEAR INTERPOLATION (Pure C with OpenMP)\n");
     printf("========================================================================\n\n");
 
-    for (t = 0; t < numTests; t++) {
-        int size = testSizes[t];
-        Image *testImg;
-        Image *resultSerial;
-        clock_t startTime, endTime;
-        double timeSerial;
+    for (t = 0; t < numTests; t++) {
+        int size = testSizes[t];
+        Image *testImg;
+        Image *resultSerial;
+        ResizePlan *plan;
+        double startTime, endTime;
+        double timeSerial;
+
+        printf("Test: Resize %dx%d -> %dx%d\n", size, size, targetSize, targetSize);
+        printf("------------------------------------------------------------------------\n");
+
+        /* Create test image */
+        testImg = createTestImage(size);
+        if (!testImg) {
+            printf("Error: Failed to create test image\n");
+            continue;
+        }
+
+        /* BENCHMARK SERIAL */
+        startTime = nowMs();
+        resultSerial = resizeSerial(testImg, targetSize, targetSize);
+        endTime = nowMs();
+        timeSerial = endTime - startTime;
+
+        printf("  [SERIAL]       Time: %7.0f ms\n", timeSerial);
+
+        if (resultSerial) freeImage(resultSerial);
+
+        /* BENCHMARK SERIAL + PLAN per ISA (plan dibuat sekali, di luar timing) */
+        plan = createResizePlan(size, size, targetSize, targetSize);
+        if (plan) {
+            const ResizeKernels *scalar = findResizeKernels("scalar");
+            Image *reference = resizeSerialPlanWith(testImg, plan, scalar);
+            int k;
+
+            for (k = 0; k < NUM_RESIZE_KERNELS; k++) {
+                const ResizeKernels *kernels = &kernelTable[k];
+                Image *resultPlan;
+                double timePlan;
+
+                if (!kernelSupported(kernels)) {
+                    printf("  [PLAN-%-7s] Not supported on this CPU\n", kernels->name);
+                    continue;
+                }
+
+                startTime = nowMs();
+                resultPlan = resizeSerialPlanWith(testImg, plan, kernels);
+                endTime = nowMs();
+                timePlan = endTime - startTime;
+
+                printf("  [PLAN-%-7s] Time: %7.0f ms  |  Speedup: %.2fx  |  Max diff vs scalar: %g\n",
+                       kernels->name, timePlan, timeSerial / timePlan,
+                       maxImageDiff(reference, resultPlan));
+
+                if (resultPlan) freeImage(resultPlan);
+            }
+
+            /* Path 8-bit RGB fixed-point (tanpa konversi ke float Pixel) */
+            {
+                ImageU8 *testImgU8 = createTestImageU8(size, 3);
+                ImageU8 *resultU8;
+                double timeU8;
+
+                if (testImgU8) {
+                    startTime = nowMs();
+                    resultU8 = resizeU8Serial(testImgU8, plan);
+                    endTime = nowMs();
+                    timeU8 = endTime - startTime;
+
+                    printf("  [PLAN-u8-rgb ] Time: %7.0f ms  |  Speedup: %.2fx  |  Max diff vs float: %d\n",
+                           timeU8, timeSerial / timeU8, maxImageU8Diff(reference, resultU8));
+
+                    if (resultU8) freeImageU8(resultU8);
+                    freeImageU8(testImgU8);
+                }
+            }
+
+            if (reference) freeImage(reference);
+        }
+
+        /* BENCHMARK OPENMP */
+#ifdef USE_OPENMP
+        {
+            int threadCounts[] = {2, 4, 8};
+            int numThreadTests = 3;
+
+            for (i = 0; i < numThreadTests; i++) {
+                int threads = threadCounts[i];
+                Image *resultOmp;
+                double timeOmp, speedup;
+
+                startTime = nowMs();
+                resultOmp = resizeOpenMP(testImg, targetSize, targetSize, threads);
+                endTime = nowMs();
+                timeOmp = endTime - startTime;
+
+                speedup = timeSerial / timeOmp;
+                printf("  [OpenMP-%d]     Time: %7.0f ms  |  Speedup: %.2fx\n",
+                       threads, timeOmp, speedup);
+
+                if (resultOmp) freeImage(resultOmp);
+
+                if (plan) {
+                    startTime = nowMs();
+                    resultOmp = resizeOpenMPPlan(testImg, plan, threads);
+                    endTime = nowMs();
+                    timeOmp = endTime - startTime;
+
+                    speedup = timeSerial / timeOmp;
+                    printf("  [OpenMP-%d-PLAN] Time: %7.0f ms  |  Speedup: %.2fx  (%s)\n",
+                           threads, timeOmp, speedup, getResizeKernels()->name);
+
+                    if (resultOmp) freeImage(resultOmp);
+                }
+            }
+        }
+#else
+        printf("  [OpenMP]       Not compiled (compile with -fopenmp -DUSE_OPENMP)\n");
+#endif
+
+        printf("\n");
+        freeResizePlan(plan);
+        freeImage(testImg);
+    }
+
+    printf("========================================================================\n");
+}
+
+/* ============================================================================
+ * SELF-TEST: FAST PATH vs PATH UMUM (--selftest)
+ * ============================================================================
+ * Beberapa path menjanjikan output identik dengan path umum: fast path rasio
+ * eksak (identity, 1/n, 2x, 4x), resizeDirtyInto, context/tiled, dan job
+ * async yang dipecah per band. Referensi float = resizeSerialPlanWith dengan
+ * kernel scalar (path umum, tanpa dispatch rasio); referensi 8-bit =
+ * resizeU8Into 1 thread dengan salinan plan ber-ratio RATIO_GENERAL. Semua
+ * path harus sama persis (selisih 0) untuk tiap geometri dan thread count.
+ * Sumber dan tujuan berupa view dengan stride > width.
+ */
+
+#define SELFTEST_THREADS 4
+
+typedef struct {
+    int srcWidth, srcHeight;
+    int dstWidth, dstHeight;
+    const char *label;
+} SelfTestCase;
+
+static const SelfTestCase selfTestCases[] = {
+    {  97,  61,   97,  61, "identity" },
+    { 640, 480,  320, 240, "1/2" },
+    { 300, 210,  100,  70, "1/3" },
+    { 100,  80,  200, 160, "2x" },
+    {  64,  48,  256, 192, "4x" },
+    { 640, 480,  333, 251, "odd down" },
+    {  97,  61,  301, 199, "odd up" },
+    {   1,   1,    5,   5, "1x1 up" },
+    {  33,  20,    1,   1, "to 1x1" },
+};
+
+typedef struct {
+    int checks;
+    int failures;
+} SelfTestTally;
+
+static unsigned selfTestSeed = 1;
+
+static unsigned selfTestNext(void) {
+    selfTestSeed = selfTestSeed * 1103515245u + 12345u;
+    return selfTestSeed >> 8;
+}
+
+/* Nilai acak [-64, 191], termasuk negatif dan pecahan */
+static float selfTestValue(void) {
+    return (float)(selfTestNext() & 0xffff) / 257.0f - 64.0f;
+}
+
+static void fillSelfTestImage(Image *img) {
+    int x, y;
+
+    for (y = 0; y < img->height; y++) {
+        for (x = 0; x < img->width; x++) {
+            Pixel *p = &img->data[(size_t)y * img->stride + x];
+
+            p->r = selfTestValue();
+            p->g = selfTestValue();
+            p->b = selfTestValue();
+        }
+    }
+}
+
+/* Isi tujuan dengan nilai yang tidak mungkin dihasilkan resize, supaya
+ * pixel yang tidak ditulis ikut terdeteksi */
+static void poisonImage(Image *img) {
+    Pixel bad = { -1.0e30f, -1.0e30f, -1.0e30f };
+    int x, y;
+
+    for (y = 0; y < img->height; y++)
+        for (x = 0; x < img->width; x++)
+            img->data[(size_t)y * img->stride + x] = bad;
+}
+
+static int sameImageU8(const ImageU8 *a, const ImageU8 *b) {
+    int y;
+
+    if (a->width != b->width || a->height != b->height || a->channels != b->channels)
+        return 0;
+    for (y = 0; y < a->height; y++) {
+        if (memcmp(a->data + (size_t)y * a->stride, b->data + (size_t)y * b->stride,
+                   (size_t)a->width * a->channels) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+static void poisonImageU8(ImageU8 *img) {
+    int y;
+
+    for (y = 0; y < img->height; y++)
+        memset(img->data + (size_t)y * img->stride, 0xA5, (size_t)img->width * img->channels);
+}
+
+static void selfTestCheck(SelfTestTally *tally, const SelfTestCase *c, const char *path,
+                          int channels, int threads, int ok) {
+    tally->checks++;
+    if (ok) return;
+
+    tally->failures++;
+    printf("  FAIL %-12s %4dx%-4d -> %4dx%-4d (%s)", path, c->srcWidth, c->srcHeight,
+           c->dstWidth, c->dstHeight, c->label);
+    if (channels) printf(" %d ch", channels);
+    printf(", %d thread(s)\n", threads);
+}
+
+#ifdef HAVE_MMAP_IO
+/* --resize lewat mmap: PGM maxval 15 dengan semua pixel 15 (putih) harus
+ * tetap putih di output, jadi maxval ikut ke header */
+static void runSelfTestFile(SelfTestTally *tally, const SelfTestCase *c) {
+    char inPath[64], outPath[64];
+    MappedImage *input, *output = NULL, *check = NULL;
+    ResizePlan *plan = createResizePlan(c->srcWidth, c->srcHeight, c->dstWidth, c->dstHeight);
+    FILE *f;
+    int ok = 0, i;
+
+    snprintf(inPath, sizeof(inPath), "/tmp/bilinear_selftest_%d_in.pgm", (int)getpid());
+    snprintf(outPath, sizeof(outPath), "/tmp/bilinear_selftest_%d_out.pgm", (int)getpid());
+
+    f = fopen(inPath, "wb");
+    if (f) {
+        fprintf(f, "P5\n%d %d\n15\n", c->srcWidth, c->srcHeight);
+        for (i = 0; i < c->srcWidth * c->srcHeight; i++) fputc(15, f);
+        fclose(f);
+    }
+
+    input = openMappedImage(inPath);
+    if (input && plan) {
+        output = createMappedImage(outPath, IMAGE_FILE_PGM, c->dstWidth, c->dstHeight,
+                                   1, input->maxval);
+    }
+    if (output && resizeU8Into(&input->image, &output->image, plan, 1) == 0 &&
+        closeMappedImage(output) == 0) {
+        check = openMappedImage(outPath);
+        ok = check && check->maxval == 15 && check->image.width == c->dstWidth &&
+             check->image.height == c->dstHeight;
+        for (i = 0; ok && i < c->dstWidth * c->dstHeight; i++)
+            ok = check->image.data[i] == 15;
+    } else {
+        closeMappedImage(output);
+    }
+
+    closeMappedImage(check);
+    closeMappedImage(input);
+    freeResizePlan(plan);
+    remove(inPath);
+    remove(outPath);
+    selfTestCheck(tally, c, "pgm maxval", 0, 1, ok);
+}
+#endif
+
+#ifdef HAVE_PTHREADS
+static int runSelfTestJob(ResizeExecutor *ex, const ResizeJob *job, int threads) {
+    AsyncResize *h = resizeSubmit(ex, job, 0, threads, NULL, NULL);
+    int ok;
+
+    if (!h) return 0;
+    ok = resizeWait(h) == ASYNC_DONE;
+    releaseAsyncResize(h);
+    return ok;
+}
+#endif
+
+static void runSelfTestFloat(SelfTestTally *tally, const SelfTestCase *c, const ResizePlan *plan,
+                             int threads, ResizeContext *ctx, ResizeExecutor *ex) {
+    const ResizeKernels *scalar = findResizeKernels("scalar");
+    Image *srcBuffer = createImage(c->srcWidth + 3, c->srcHeight);
+    Image *dstBuffer = createImage(c->dstWidth + 5, c->dstHeight);
+    Image *ref = NULL;
+    Image src, dst;
+
+    if (!srcBuffer || !dstBuffer) {
+        selfTestCheck(tally, c, "alloc", 0, threads, 0);
+        goto done;
+    }
+    fillSelfTestImage(srcBuffer);
+    src = imageRegion(srcBuffer, 1, 0, c->srcWidth, c->srcHeight);
+    dst = imageRegion(dstBuffer, 2, 0, c->dstWidth, c->dstHeight);
+
+    ref = resizeSerialPlanWith(&src, plan, scalar);
+    poisonImage(&dst);
+    selfTestCheck(tally, c, "plan", 0, threads,
+                  resizeIntoPlan(&src, &dst, plan, threads) == 0 && maxImageDiff(ref, &dst) == 0.0);
+
+    /* Sunting dua rectangle sumber (tengah & pojok), dest hanya diperbarui
+     * di bagian yang terpengaruh */
+    {
+        DirtyRect rects[2];
+        int i, x, y;
+
+        rects[0].x = c->srcWidth / 4;
+        rects[0].y = c->srcHeight / 3;
+        rects[0].width = c->srcWidth / 3 + 1;
+        rects[0].height = 2;
+        rects[1].x = c->srcWidth - 1;
+        rects[1].y = c->srcHeight - 1;
+        rects[1].width = 1;
+        rects[1].height = 1;
+
+        for (i = 0; i < 2; i++) {
+            for (y = rects[i].y; y < rects[i].y + rects[i].height && y < c->srcHeight; y++) {
+                for (x = rects[i].x; x < rects[i].x + rects[i].width && x < c->srcWidth; x++) {
+                    Pixel *p = &src.data[(size_t)y * src.stride + x];
+
+                    p->r = selfTestValue();
+                    p->g = selfTestValue();
+                    p->b = selfTestValue();
+                }
+            }
+        }
+
+        freeImage(ref);
+        ref = resizeSerialPlanWith(&src, plan, scalar);
+        selfTestCheck(tally, c, "dirty", 0, threads,
+                      resizeDirtyInto(&src, &dst, rects, 2, threads) == 0 &&
+                      maxImageDiff(ref, &dst) == 0.0);
+    }
+
+#ifdef HAVE_PTHREADS
+    {
+        ResizeTiling tiling = { 37, 19 };
+        ResizeJob job;
+
+        poisonImage(&dst);
+        selfTestCheck(tally, c, "context", 0, threads,
+                      resizeContextInto(ctx, &src, &dst, plan, threads) == 0 &&
+                      maxImageDiff(ref, &dst) == 0.0);
+
+        poisonImage(&dst);
+        selfTestCheck(tally, c, "tiled", 0, threads,
+                      resizeTiledInto(ctx, &src, &dst, plan, &tiling, NULL, threads) == 0 &&
+                      maxImageDiff(ref, &dst) == 0.0);
+
+        memset(&job, 0, sizeof(job));
+        job.source = &src;
+        job.dest = &dst;
+        poisonImage(&dst);
+        selfTestCheck(tally, c, "async", 0, threads,
+                      runSelfTestJob(ex, &job, threads) && maxImageDiff(ref, &dst) == 0.0);
+    }
+#else
+    (void)ctx; (void)ex;
+#endif
+
+done:
+    freeImage(ref);
+    freeImage(srcBuffer);
+    freeImage(dstBuffer);
+}
+
+static void runSelfTestU8(SelfTestTally *tally, const SelfTestCase *c, const ResizePlan *plan,
+                          int channels, int threads, ResizeContext *ctx, ResizeExecutor *ex) {
+    ImageU8 *srcBuffer = createImageU8(c->srcWidth + 3, c->srcHeight, channels);
+    ImageU8 *dstBuffer = createImageU8(c->dstWidth + 5, c->dstHeight, channels);
+    ImageU8 *ref = createImageU8(c->dstWidth, c->dstHeight, channels);
+    ResizePlan general;
+    ImageU8 src, dst;
+    int i;
+
+    if (!srcBuffer || !dstBuffer || !ref) {
+        selfTestCheck(tally, c, "u8 alloc", channels, threads, 0);
+        goto done;
+    }
+    for (i = 0; i < srcBuffer->stride * srcBuffer->height; i++)
+        srcBuffer->data[i] = (uint8_t)selfTestNext();
+    src = imageU8Region(srcBuffer, 1, 0, c->srcWidth, c->srcHeight);
+    dst = imageU8Region(dstBuffer, 2, 0, c->dstWidth, c->dstHeight);
+
+    general = *plan;
+    general.ratio = RATIO_GENERAL;
+    if (resizeU8Into(&src, ref, &general, 1) != 0) {
+        selfTestCheck(tally, c, "u8 general", channels, threads, 0);
+        goto done;
+    }
+
+    poisonImageU8(&dst);
+    selfTestCheck(tally, c, "u8", channels, threads,
+                  resizeU8Into(&src, &dst, plan, threads) == 0 && sameImageU8(ref, &dst));
+
+#ifdef HAVE_PTHREADS
+    {
+        ResizeTiling tiling = { 37, 19 };
+        ResizeJob job;
+
+        poisonImageU8(&dst);
+        selfTestCheck(tally, c, "u8-context", channels, threads,
+                      resizeContextU8Into(ctx, &src, &dst, plan, threads) == 0 &&
+                      sameImageU8(ref, &dst));
+
+        poisonImageU8(&dst);
+        selfTestCheck(tally, c, "u8-tiled", channels, threads,
+                      resizeTiledU8Into(ctx, &src, &dst, plan, &tiling, NULL, threads) == 0 &&
+                      sameImageU8(ref, &dst));
+
+        memset(&job, 0, sizeof(job));
+        job.sourceU8 = &src;
+        job.destU8 = &dst;
+        poisonImageU8(&dst);
+        selfTestCheck(tally, c, "u8-async", channels, threads,
+                      runSelfTestJob(ex, &job, threads) && sameImageU8(ref, &dst));
+    }
+#else
+    (void)ctx; (void)ex;
+#endif
+
+done:
+    freeImageU8(ref);
+    freeImageU8(srcBuffer);
+    freeImageU8(dstBuffer);
+}
+
+/* Return exit code: 0 semua cocok, 1 ada yang berbeda */
+int runSelfTest(void) {
+    static const int channelList[] = { 1, 3, 4 };
+    int numCases = (int)(sizeof(selfTestCases) / sizeof(selfTestCases[0]));
+    int threadList[2] = { 1, SELFTEST_THREADS };
+    SelfTestTally tally = { 0, 0 };
+    ResizeContext *ctx = NULL;
+    ResizeExecutor *ex = NULL;
+    int i, t, ch;
+
+#ifdef HAVE_PTHREADS
+    ctx = createResizeContext(SELFTEST_THREADS, 0);
+    ex = createResizeExecutor(2);
+    if (!ctx || !ex) {
+        fprintf(stderr, "Error: cannot start worker threads\n");
+        freeResizeContext(ctx);
+        freeResizeExecutor(ex);
+        return 1;
+    }
+#endif
+
+    printf("Self-test: fast paths vs general path (scalar reference, %s active)\n",
+           getResizeKernels()->name);
+
+    for (i = 0; i < numCases; i++) {
+        const SelfTestCase *c = &selfTestCases[i];
+        ResizePlan *plan = createResizePlan(c->srcWidth, c->srcHeight, c->dstWidth, c->dstHeight);
+        int before = tally.failures;
+
+        if (!plan) {
+            fprintf(stderr, "Error: cannot create plan\n");
+            tally.failures++;
+            continue;
+        }
+        for (t = 0; t < 2; t++) {
+            runSelfTestFloat(&tally, c, plan, threadList[t], ctx, ex);
+            for (ch = 0; ch < 3; ch++)
+                runSelfTestU8(&tally, c, plan, channelList[ch], threadList[t], ctx, ex);
+        }
+        printf("  %-9s %4dx%-4d -> %4dx%-4d  %s\n", c->label, c->srcWidth, c->srcHeight,
+               c->dstWidth, c->dstHeight, tally.failures == before ? "ok" : "FAILED");
+        freeResizePlan(plan);
+    }
+
+#ifdef HAVE_MMAP_IO
+    {
+        static const SelfTestCase fileCase = { 4, 4, 8, 8, "pgm 15" };
+        int before = tally.failures;
+
+        runSelfTestFile(&tally, &fileCase);
+        printf("  %-9s %4dx%-4d -> %4dx%-4d  %s\n", fileCase.label, fileCase.srcWidth,
+               fileCase.srcHeight, fileCase.dstWidth, fileCase.dstHeight,
+               tally.failures == before ? "ok" : "FAILED");
+    }
+#endif
+
+#ifdef HAVE_PTHREADS
+    freeResizeExecutor(ex);
+    freeResizeContext(ctx);
+#endif
+
+    printf("%d checks, %d failed\n", tally.checks, tally.failures);
+    return tally.failures ? 1 : 0;
+}
+
+/* ============================================================================
+ * BENCHMARK HARNESS (--bench)
+ * ============================================================================
+ * Setiap konfigurasi (ukuran, rasio, threads, varian) dijalankan warm-up
+ * kali lalu N repetisi dengan timing wall-clock; dilaporkan min/median/p95,
+ * megapixel/s dan GB/s. GB/s = (byte sumber dibaca + byte tujuan ditulis)
+ * / median, yaitu traffic minimum, bukan traffic DRAM sebenarnya.
+ * Alokasi image tujuan termasuk dalam waktu, kecuali varian "into" yang
+ * menulis ke buffer tujuan yang dipakai ulang.
+ */
+
+#define BENCH_MAX_LIST 32
+
+typedef enum { FORMAT_TEXT, FORMAT_CSV, FORMAT_JSON } OutputFormat;
+
+typedef struct {
+    int sizes[BENCH_MAX_LIST];
+    int numSizes;
+    double ratios[BENCH_MAX_LIST];
+    int numRatios;
+    int threads[BENCH_MAX_LIST];
+    int numThreads;
+    int threadsGiven;       /* --threads eksplisit (--scaling: default 1..max) */
+    int warmup;
+    int reps;
+    OutputFormat format;
+    const char *variants;   /* filter prefix dipisah koma, NULL = semua */
+    const char *input;      /* file PPM/PGM sebagai sumber, NULL = test image */
+    int tileWidth, tileHeight;  /* varian tiled, 0 = default */
+    int numaPolicy;         /* NumaSourcePolicy untuk varian tiled */
+    const char *profile;    /* file laporan instrumentasi, NULL = tidak */
+    HugePageMode hugePages; /* backing buffer image >= 2 MB */
+    int poolMB;             /* batas pool buffer image, -1 = default */
+} BenchConfig;
+
+typedef struct {
+    const Image *source;
+    const ImageU8 *sourceU8;
+    const ResizePlan *plan;
+    const ResizeKernels *kernels;
+    Image *dest;            /* buffer tujuan dipakai ulang (varian into) */
+    ImageU8 *destU8;
+    ResizeJob *jobs;        /* BENCH_BATCH_JOBS job (varian batch), bisa NULL */
+    ResizeRoi *rois;        /* BENCH_BATCH_JOBS ROI grid 4x4 (varian roi), bisa NULL */
+    float *tensor;          /* 3 x dstHeight x dstWidth (varian tensor) */
+    RasterView u16Src, u16Dst;  /* varian raster, data NULL jika tidak dipilih */
+    RasterView f16Src, f16Dst;
+    RemapMap *remapMap;     /* varian remap: skala + rotasi 5 derajat */
+    PackedRemap *packed;
+    PackedRemap *packedU8;
+#ifdef HAVE_PTHREADS
+    ResizeContext *ctx;     /* pool persisten (varian pool/tiled) */
+    ResizeTiling tiling;
+    const NumaSource *numa;
+    const NumaSource *numaU8;
+    ResizeExecutor *executor;   /* varian async, dibuat per thread count */
+#endif
+    int dstWidth, dstHeight;
+    int threads;
+} BenchInput;
+
+typedef struct {
+    const char *name;
+    int threaded;           /* 1 = diulang untuk setiap thread count */
+    int u8;                 /* 1 = path 8-bit (byte/pixel = channels) */
+    int images;             /* image per run (throughput batch) */
+    void* (*run)(const BenchInput *in);
+    void (*release)(void *result);
+    int pixelBytes;         /* > 0: byte per pixel eksplisit (varian raster) */
+    int dstPixelBytes;      /* > 0: byte per pixel tujuan jika beda dari sumber */
+} BenchVariant;
+
+typedef struct {
+    char variant[32];
+    int srcWidth, srcHeight;
+    int dstWidth, dstHeight;
+    int threads;
+    int reps;
+    double minMs, medianMs, p95Ms;
+    double mpixPerSec, gbPerSec;
+} BenchRecord;
+
+#ifdef RESIZE_INSTRUMENT
+/* --profile: satu laporan instrumentasi per record (hanya repetisi terukur) */
+static FILE *benchProfileOut = NULL;
+#endif
+
+static void releaseImage(void *img) { freeImage((Image*)img); }
+static void releaseImageU8(void *img) { freeImageU8((ImageU8*)img); }
+static void releaseNothing(void *img) { (void)img; }
+
+#ifdef USE_OPENMP
+#define BENCH_THREADED 1
+#else
+#define BENCH_THREADED 0
+#endif
+
+static void* benchSerial(const BenchInput *in) {
+    return resizeSerial(in->source, in->dstWidth, in->dstHeight);
+}
+
+static void* benchPlan(const BenchInput *in) {
+    return resizeSerialPlanWith(in->source, in->plan, in->kernels);
+}
+
+static void* benchU8(const BenchInput *in) {
+    return resizeU8Serial(in->sourceU8, in->plan);
+}
+
+static void* benchInto(const BenchInput *in) {
+    return resizeIntoPlan(in->source, in->dest, in->plan, in->threads) == 0 ? in->dest : NULL;
+}
+
+/* Seperti into, tapi plan dicari di plan cache per panggilan (resizeInto) */
+static void* benchCached(const BenchInput *in) {
+    return resizeInto(in->source, in->dest, in->threads) == 0 ? in->dest : NULL;
+}
+
+#define BENCH_DIRTY_RECTS 9
+
+/* Edit kecil: goresan kuas 8 kotak sisi min(w, h) / 32 yang saling tumpang
+ * tindih (digabung jadi satu rectangle) plus satu titik di pojok lain.
+ * Throughput dihitung sebagai ekuivalen satu frame penuh. */
+static void* benchDirty(const BenchInput *in) {
+    DirtyRect rects[BENCH_DIRTY_RECTS];
+    int side = mini(in->source->width, in->source->height) / 32;
+    int k;
+
+    if (side < 1) side = 1;
+    for (k = 0; k < BENCH_DIRTY_RECTS - 1; k++) {
+        rects[k].x = in->source->width / 4 + k * side / 2;
+        rects[k].y = in->source->height / 4;
+        rects[k].width = side;
+        rects[k].height = side;
+    }
+    rects[k].x = in->source->width * 3 / 4;
+    rects[k].y = in->source->height * 3 / 4;
+    rects[k].width = side;
+    rects[k].height = side;
+
+    return resizeDirtyInto(in->source, in->dest, rects, BENCH_DIRTY_RECTS, in->threads) == 0
+               ? in->dest : NULL;
+}
+
+/* Sink streaming: salin baris tujuan ke image */
+static void copyRowToImage(void *userData, int y, const Pixel *row) {
+    Image *dest = (Image*)userData;
+    memcpy(dest->data + (size_t)y * dest->stride, row, dest->width * sizeof(Pixel));
+}
+
+static void* benchStream(const BenchInput *in) {
+    ResizeStream *stream = createResizeStream(in->source->width, in->source->height,
+                                              in->dstWidth, in->dstHeight,
+                                              copyRowToImage, in->dest);
+    int y;
+
+    if (!stream) return NULL;
+    for (y = 0; y < in->source->height; y++) {
+        resizeStreamPush(stream, in->source->data + (size_t)y * in->source->stride);
+    }
+    y = resizeStreamDone(stream);
+    freeResizeStream(stream);
+    return y ? in->dest : NULL;
+}
+
+#define BENCH_BATCH_JOBS 16
+#define BENCH_BATCH_MAX_PIXELS (1024 * 1024)
+#define BENCH_PIPELINE_FRAMES 8
+
+static void* benchRoi(const BenchInput *in) {
+    if (!in->rois) return NULL;
+    return resizeRoiBatch(NULL, in->sourceU8, in->rois, BENCH_BATCH_JOBS, in->threads) == 0
+           ? in->rois : NULL;
+}
+
+/* Normalisasi ImageNet, NCHW, BGR */
+static const TensorFormat benchTensorFormat = {
+    TENSOR_NCHW, 1, 1.0f / 255.0f, { 0.406f, 0.456f, 0.485f }, { 0.225f, 0.224f, 0.229f }
+};
+
+static void* benchTensor(const BenchInput *in) {
+    return resizeToTensor(in->source, in->tensor, in->plan, &benchTensorFormat, in->threads) == 0
+           ? in->tensor : NULL;
+}
+
+static void* benchU8Tensor(const BenchInput *in) {
+    return resizeU8ToTensor(in->sourceU8, in->tensor, in->plan, &benchTensorFormat, in->threads) == 0
+           ? in->tensor : NULL;
+}
+
+static void* benchU16Gray(const BenchInput *in) {
+    RasterView dst = in->u16Dst;
+    return resizeRaster(&in->u16Src, &dst, in->plan, in->threads) == 0 ? in->u16Dst.data : NULL;
+}
+
+static void* benchF16Rgba(const BenchInput *in) {
+    RasterView dst = in->f16Dst;
+    return resizeRaster(&in->f16Src, &dst, in->plan, in->threads) == 0 ? in->f16Dst.data : NULL;
+}
+
+/* Raster uji dari sumber float: u16 gray (luma * 257) dan f16 RGBA (alpha 1) */
+static void createBenchRasters(BenchInput *in, const Image *source) {
+    int sw = source->width, sh = source->height, dw = in->dstWidth, dh = in->dstHeight;
+    uint16_t *gray = (uint16_t*)malloc((size_t)sw * sh * sizeof(uint16_t));
+    uint16_t *rgba = (uint16_t*)malloc((size_t)sw * sh * 4 * sizeof(uint16_t));
+    int x, y;
+
+    in->u16Src = rasterView(gray, sw, sh, 1, ELEM_U16, (size_t)sw * sizeof(uint16_t));
+    in->u16Dst = rasterView(malloc((size_t)dw * dh * sizeof(uint16_t)), dw, dh, 1, ELEM_U16,
+                            (size_t)dw * sizeof(uint16_t));
+    in->f16Src = rasterView(rgba, sw, sh, 4, ELEM_F16, (size_t)sw * 4 * sizeof(uint16_t));
+    in->f16Dst = rasterView(malloc((size_t)dw * dh * 4 * sizeof(uint16_t)), dw, dh, 4, ELEM_F16,
+                            (size_t)dw * 4 * sizeof(uint16_t));
+    if (!gray || !rgba) return;
+
+    for (y = 0; y < sh; y++) {
+        for (x = 0; x < sw; x++) {
+            Pixel p = getPixel(source, x, y);
+            uint16_t *q = rgba + ((size_t)y * sw + x) * 4;
+
+            gray[(size_t)y * sw + x] = storeSatU16((0.299f * p.r + 0.587f * p.g + 0.114f * p.b) * 257.0f);
+            q[0] = floatToHalf(p.r / 255.0f);
+            q[1] = floatToHalf(p.g / 255.0f);
+            q[2] = floatToHalf(p.b / 255.0f);
+            q[3] = floatToHalf(1.0f);
+        }
+    }
+}
+
+static void freeBenchRasters(BenchInput *in) {
+    free(in->u16Src.data);
+    free(in->u16Dst.data);
+    free(in->f16Src.data);
+    free(in->f16Dst.data);
+}
+
+static void* benchArea(const BenchInput *in) {
+    return resizeAreaInto(in->source, in->dest, in->threads) == 0 ? in->dest : NULL;
+}
+
+static void* benchMipmap(const BenchInput *in) {
+    return resizeMipmapInto(in->source, in->dest, in->threads) == 0 ? in->dest : NULL;
+}
+
+static void* benchRemap(const BenchInput *in) {
+    return remapInto(in->source, in->dest, in->remapMap, REMAP_BORDER_CONSTANT, in->threads) == 0
+           ? in->dest : NULL;
+}
+
+static void* benchRemapPacked(const BenchInput *in) {
+    return remapPackedInto(in->source, in->dest, in->packed, in->threads) == 0 ? in->dest : NULL;
+}
+
+static void* benchU8RemapPacked(const BenchInput *in) {
+    return remapPackedU8Into(in->sourceU8, in->destU8, in->packedU8, in->threads) == 0
+           ? in->destU8 : NULL;
+}
+
+/* Peta uji: skala sumber -> tujuan plus rotasi 5 derajat di tengah */
+static RemapMap* createBenchRemapMap(int srcWidth, int srcHeight, int dstWidth, int dstHeight) {
+    double angle = 5.0 * 3.14159265358979 / 180.0;
+    double sx = (double)srcWidth / dstWidth, sy = (double)srcHeight / dstHeight;
+    double cx = 0.5 * dstWidth, cy = 0.5 * dstHeight;
+    double m[6];
+
+    m[0] = sx * cos(angle);
+    m[1] = -sx * sin(angle);
+    m[3] = sy * sin(angle);
+    m[4] = sy * cos(angle);
+    m[2] = 0.5 * srcWidth - m[0] * cx - m[1] * cy;
+    m[5] = 0.5 * srcHeight - m[3] * cx - m[4] * cy;
+    return createAffineMap(dstWidth, dstHeight, m);
+}
+
+/* Pyramid: level tujuan, 1/2, 1/4, 1/8 dalam satu pass (MP/s dari level
+ * terbesar saja). Hasil = array level NULL-terminated. */
+#define BENCH_PYRAMID_LEVELS 4
+
+static void* benchPyramid(const BenchInput *in) {
+    int widths[BENCH_PYRAMID_LEVELS], heights[BENCH_PYRAMID_LEVELS];
+    Image **levels = (Image**)calloc(BENCH_PYRAMID_LEVELS + 1, sizeof(Image*));
+    int i;
+
+    if (!levels) return NULL;
+    for (i = 0; i < BENCH_PYRAMID_LEVELS; i++) {
+        widths[i] = in->dstWidth >> i > 0 ? in->dstWidth >> i : 1;
+        heights[i] = in->dstHeight >> i > 0 ? in->dstHeight >> i : 1;
+    }
+    if (resizePyramid(in->source, widths, heights, BENCH_PYRAMID_LEVELS, levels) != 0) {
+        free(levels);
+        return NULL;
+    }
+    return levels;
+}
+
+static void releasePyramid(void *result) {
+    Image **levels = (Image**)result;
+    int i;
+
+    for (i = 0; levels[i]; i++) freeImage(levels[i]);
+    free(levels);
+}
+
+
+static void* benchBatch(const BenchInput *in) {
+    if (!in->jobs) return NULL;
+    return resizeBatch(in->jobs, BENCH_BATCH_JOBS, in->threads) == 0 ? in->jobs : NULL;
+}
+
+#ifdef HAVE_PTHREADS
+/* Job batch yang sama lewat resizeSubmit (prioritas bergantian), lalu
+ * tunggu semua handle: overhead antrean + handoff dibanding resizeBatch */
+static void* benchAsync(const BenchInput *in) {
+    AsyncResize *handles[BENCH_BATCH_JOBS];
+    int k, failed = 0;
+
+    if (!in->jobs || !in->executor) return NULL;
+
+    for (k = 0; k < BENCH_BATCH_JOBS; k++)
+        handles[k] = resizeSubmit(in->executor, &in->jobs[k], k % 2, 1, NULL, NULL);
+    for (k = 0; k < BENCH_BATCH_JOBS; k++) {
+        if (!handles[k] || resizeWait(handles[k]) != ASYNC_DONE) failed++;
+        releaseAsyncResize(handles[k]);
+    }
+    return failed ? NULL : in->jobs;
+}
+
+/* Pipeline: "baca" = salin sumber ke slot, "tulis" = salin hasil ke dest;
+ * mengukur overhead ring + thread, bukan I/O disk */
+static void copyImageRows(Image *dest, const Image *src) {
+    int y;
+
+    for (y = 0; y < src->height; y++)
+        copyRowToImage(dest, y, src->data + (size_t)y * src->stride);
+}
+
+static int benchFrameProducer(void *userData, long index, Image *frame) {
+    const BenchInput *in = (const BenchInput*)userData;
+
+    if (index >= BENCH_PIPELINE_FRAMES) return 0;
+    copyImageRows(frame, in->source);
+    return 1;
+}
+
+static int benchFrameConsumer(void *userData, long index, const Image *frame) {
+    const BenchInput *in = (const BenchInput*)userData;
+
+    (void)index;
+    copyImageRows(in->dest, frame);
+    return 0;
+}
+
+static void* benchPipeline(const BenchInput *in) {
+    FramePipelineConfig cfg;
+
+    cfg.srcWidth = in->source->width;
+    cfg.srcHeight = in->source->height;
+    cfg.dstWidth = in->dstWidth;
+    cfg.dstHeight = in->dstHeight;
+    cfg.depth = DEFAULT_PIPELINE_DEPTH;
+    cfg.threads = in->threads;
+    cfg.ctx = NULL;
+    return resizeFramePipeline(&cfg, benchFrameProducer, benchFrameConsumer, (void*)in, NULL)
+           == BENCH_PIPELINE_FRAMES ? in->dest : NULL;
+}
+
+static void* benchPool(const BenchInput *in) {
+    return resizeContextInto(in->ctx, in->source, in->dest, in->plan, in->threads) == 0
+           ? in->dest : NULL;
+}
+
+static void* benchU8Pool(const BenchInput *in) {
+    return resizeContextU8Into(in->ctx, in->sourceU8, in->destU8, in->plan, in->threads) == 0
+           ? in->destU8 : NULL;
+}
+
+static void* benchTiled(const BenchInput *in) {
+    return resizeTiledInto(in->ctx, in->source, in->dest, in->plan, &in->tiling,
+                           in->numa, in->threads) == 0 ? in->dest : NULL;
+}
+
+static void* benchU8Tiled(const BenchInput *in) {
+    return resizeTiledU8Into(in->ctx, in->sourceU8, in->destU8, in->plan, &in->tiling,
+                             in->numaU8, in->threads) == 0 ? in->destU8 : NULL;
+}
+#endif
+
+static void* benchU8Into(const BenchInput *in) {
+    return resizeU8Into(in->sourceU8, in->destU8, in->plan, in->threads) == 0 ? in->destU8 : NULL;
+}
+
+#ifdef USE_OPENMP
+static void* benchOpenMP(const BenchInput *in) {
+    return resizeOpenMP(in->source, in->dstWidth, in->dstHeight, in->threads);
+}
+
+static void* benchOpenMPPlan(const BenchInput *in) {
+    return resizeOpenMPPlan(in->source, in->plan, in->threads);
+}
+
+static void* benchU8OpenMP(const BenchInput *in) {
+    return resizeU8OpenMP(in->sourceU8, in->plan, in->threads);
+}
+#endif
+
+/* Varian "plan" dijalankan sekali per ISA yang didukung (kernels diisi loop) */
+static const BenchVariant benchVariants[] = {
+    { "serial",      0,              0, 1, benchSerial,     releaseImage },
+    { "plan",        0,              0, 1, benchPlan,       releaseImage },
+    { "u8",          0,              1, 1, benchU8,         releaseImageU8 },
+    { "into",        BENCH_THREADED, 0, 1, benchInto,       releaseNothing },
+    { "cached",      BENCH_THREADED, 0, 1, benchCached,     releaseNothing },
+    { "dirty",       BENCH_THREADED, 0, 1, benchDirty,      releaseNothing },
+    { "u8-into",     BENCH_THREADED, 1, 1, benchU8Into,     releaseNothing },
+    { "stream",      0,              0, 1, benchStream,     releaseNothing },
+    { "batch",       BENCH_THREADED, 1, BENCH_BATCH_JOBS, benchBatch, releaseNothing },
+    { "area",        BENCH_THREADED, 0, 1, benchArea,       releaseNothing },
+    { "mipmap",      BENCH_THREADED, 0, 1, benchMipmap,     releaseNothing },
+    { "roi",         BENCH_THREADED, 1, 1, benchRoi,        releaseNothing },
+    { "tensor",      BENCH_THREADED, 0, 1, benchTensor,     releaseNothing },
+    { "u8-tensor",   BENCH_THREADED, 1, 1, benchU8Tensor,   releaseNothing, 0, 3 * sizeof(float) },
+    { "u16-gray",    BENCH_THREADED, 0, 1, benchU16Gray,    releaseNothing, 2 },
+    { "f16-rgba",    BENCH_THREADED, 0, 1, benchF16Rgba,    releaseNothing, 8 },
+    { "pyramid",     0,              0, 1, benchPyramid,    releasePyramid },
+    { "remap",       BENCH_THREADED, 0, 1, benchRemap,      releaseNothing },
+    { "remap-packed", BENCH_THREADED, 0, 1, benchRemapPacked, releaseNothing },
+    { "u8-remap-packed", BENCH_THREADED, 1, 1, benchU8RemapPacked, releaseNothing },
+#ifdef HAVE_PTHREADS
+    { "pool",        1,              0, 1, benchPool,       releaseNothing },
+    { "u8-pool",     1,              1, 1, benchU8Pool,     releaseNothing },
+    { "tiled",       1,              0, 1, benchTiled,      releaseNothing },
+    { "u8-tiled",    1,              1, 1, benchU8Tiled,    releaseNothing },
+    { "pipeline",    BENCH_THREADED, 0, BENCH_PIPELINE_FRAMES, benchPipeline, releaseNothing },
+    { "async",       1,              1, BENCH_BATCH_JOBS, benchAsync, releaseNothing },
+#endif
+#ifdef USE_OPENMP
+    { "openmp",      1,              0, 1, benchOpenMP,     releaseImage },
+    { "openmp-plan", 1,              0, 1, benchOpenMPPlan, releaseImage },
+    { "u8-openmp",   1,              1, 1, benchU8OpenMP,   releaseImageU8 },
+#endif
+};
+
+#define NUM_BENCH_VARIANTS ((int)(sizeof(benchVariants) / sizeof(benchVariants[0])))
+
+static int variantSelected(const BenchConfig *cfg, const char *name) {
+    const char *p = cfg->variants;
+
+    if (!p) return 1;
+    while (*p) {
+        size_t len = strcspn(p, ",");
+        if (len == strlen(name) && strncmp(p, name, len) == 0) return 1;
+        p += len;
+        if (*p == ',') p++;
+    }
+    return 0;
+}
+
+static int compareDouble(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* Jalankan warm-up + reps, isi statistik waktu; return 0 jika sukses */
+static int measureVariant(const BenchConfig *cfg, const BenchVariant *v,
+                          const BenchInput *in, BenchRecord *rec) {
+    double *times;
+    double seconds, pixels, bytes;
+    int srcPixelBytes, i;
+
+    times = (double*)malloc(cfg->reps * sizeof(double));
+    if (!times) return -1;
+
+    for (i = 0; i < cfg->warmup + cfg->reps; i++) {
+        double start, elapsed;
+        void *result;
+
+#ifdef RESIZE_INSTRUMENT
+        if (i == cfg->warmup) resizeProfileReset();
+#endif
+        start = nowMs();
+        result = v->run(in);
+        elapsed = nowMs() - start;
+
+        if (!result) {
+            free(times);
+            return -1;
+        }
+        v->release(result);
+        if (i >= cfg->warmup) times[i - cfg->warmup] = elapsed;
+    }
+
+    qsort(times, cfg->reps, sizeof(double), compareDouble);
+    rec->reps = cfg->reps;
+    rec->minMs = times[0];
+    rec->medianMs = (cfg->reps % 2) ? times[cfg->reps / 2]
+                  : 0.5 * (times[cfg->reps / 2 - 1] + times[cfg->reps / 2]);
+    rec->p95Ms = times[(int)ceil(0.95 * cfg->reps) - 1];
+
+    seconds = rec->medianMs / 1000.0;
+    pixels = (double)in->dstWidth * in->dstHeight * v->images;
+    srcPixelBytes = v->pixelBytes > 0 ? v->pixelBytes :
+                    v->u8 ? in->sourceU8->channels : (int)sizeof(Pixel);
+    bytes = (double)in->plan->srcWidth * in->plan->srcHeight * v->images * srcPixelBytes +
+            pixels * (v->dstPixelBytes > 0 ? v->dstPixelBytes : srcPixelBytes);
+    rec->mpixPerSec = pixels / seconds / 1.0e6;
+    rec->gbPerSec = bytes / seconds / 1.0e9;
+
+    free(times);
+    return 0;
+}
+
+static void printBenchHeader(const BenchConfig *cfg) {
+    switch (cfg->format) {
+        case FORMAT_CSV:
+            printf("variant,src_width,src_height,dst_width,dst_height,threads,reps,"
+                   "min_ms,median_ms,p95_ms,mpix_per_s,gb_per_s\n");
+            break;
+        case FORMAT_JSON:
+            printf("{\n  \"benchmark\": \"bilinear\",\n");
+            printf("  \"kernel\": \"%s\",\n", getResizeKernels()->name);
+#ifdef USE_OPENMP
+            printf("  \"max_threads\": %d,\n", omp_get_max_threads());
+#else
+            printf("  \"max_threads\": 1,\n");
+#endif
+            printf("  \"warmup\": %d,\n  \"results\": [", cfg->warmup);
+            break;
+        default:
+            printf("%-18s %11s %11s %4s %10s %10s %10s %9s %8s\n",
+                   "variant", "src", "dst", "thr", "min ms", "median ms", "p95 ms",
+                   "MP/s", "GB/s");
+            printf("-----------------------------------------------------------------------------------------------\n");
+            break;
+    }
+}
+
+static void printBenchRecord(const BenchConfig *cfg, const BenchRecord *r, int index) {
+    char src[32], dst[32];
+
+    switch (cfg->format) {
+        case FORMAT_CSV:
+            printf("%s,%d,%d,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.2f,%.3f\n",
+                   r->variant, r->srcWidth, r->srcHeight, r->dstWidth, r->dstHeight, r->threads,
+                   r->reps, r->minMs, r->medianMs, r->p95Ms, r->mpixPerSec, r->gbPerSec);
+            break;
+        case FORMAT_JSON:
+            printf("%s\n    {\"variant\": \"%s\", \"src_width\": %d, \"src_height\": %d, "
+                   "\"dst_width\": %d, "
+                   "\"dst_height\": %d, \"threads\": %d, \"reps\": %d, \"min_ms\": %.4f, "
+                   "\"median_ms\": %.4f, \"p95_ms\": %.4f, \"mpix_per_s\": %.2f, "
+                   "\"gb_per_s\": %.3f}",
+                   index ? "," : "", r->variant, r->srcWidth, r->srcHeight,
+                   r->dstWidth, r->dstHeight,
+                   r->threads, r->reps, r->minMs, r->medianMs, r->p95Ms,
+                   r->mpixPerSec, r->gbPerSec);
+            break;
+        default:
+            snprintf(src, sizeof(src), "%dx%d", r->srcWidth, r->srcHeight);
+            snprintf(dst, sizeof(dst), "%dx%d", r->dstWidth, r->dstHeight);
+            printf("%-18s %11s %11s %4d %10.3f %10.3f %10.3f %9.1f %8.2f\n",
+                   r->variant, src, dst, r->threads,
+                   r->minMs, r->medianMs, r->p95Ms, r->mpixPerSec, r->gbPerSec);
+            break;
+    }
+    fflush(stdout);
+}
+
+static void printBenchFooter(const BenchConfig *cfg) {
+    if (cfg->format == FORMAT_JSON) printf("\n  ]\n}\n");
+}
+
+static void writeBenchProfile(const BenchRecord *r, int index) {
+#ifdef RESIZE_INSTRUMENT
+    ResizeProfile profile;
+
+    if (!benchProfileOut) return;
+
+    resizeProfileSnapshot(&profile);
+    fprintf(benchProfileOut, "%s\n  {\"variant\": \"%s\", \"src_width\": %d, \"src_height\": %d, "
+            "\"dst_width\": %d, \"dst_height\": %d, \"threads\": %d, \"reps\": %d, "
+            "\"profile\": ",
+            index ? "," : "", r->variant, r->srcWidth, r->srcHeight,
+            r->dstWidth, r->dstHeight, r->threads, r->reps);
+    resizeProfileWriteJson(benchProfileOut, &profile);
+    fprintf(benchProfileOut, "}");
+#else
+    (void)r;
+    (void)index;
+#endif
+}
+
+/* Jalankan semua rasio x varian x threads untuk satu sumber */
+static void benchSource(const BenchConfig *cfg, const Image *source,
+                        const ImageU8 *sourceU8, void *ctx, int *count) {
+    int r, v, t, k;
+#ifdef HAVE_PTHREADS
+    NumaSource *numa = NULL, *numaU8 = NULL;
 
-        printf("Test: Resize %dx%d -> %dx%d\n", size, size, targetSize, targetSize);
-        printf("------------------------------------------------------------------------\n");
+    if (ctx && cfg->numaPolicy != NUMA_SOURCE_SHARED) {
+        numa = createNumaSource(source->data,
+                                (size_t)source->stride * source->height * sizeof(Pixel),
+                                (NumaSourcePolicy)cfg->numaPolicy);
+        numaU8 = createNumaSource(sourceU8->data, (size_t)sourceU8->stride * sourceU8->height,
+                                  (NumaSourcePolicy)cfg->numaPolicy);
+    }
+#endif
 
-        /* Create test image */
-        testImg = createTestImage(size);
-        if (!testImg) {
-            printf("Error: Failed to create test image\n");
+    for (r = 0; r < cfg->numRatios; r++) {
+        BenchInput in;
+        ResizePlan *plan;
+        int dstWidth = (int)lrint(source->width * cfg->ratios[r]);
+        int dstHeight = (int)lrint(source->height * cfg->ratios[r]);
+
+        if (dstWidth < 1) dstWidth = 1;
+        if (dstHeight < 1) dstHeight = 1;
+        plan = createResizePlan(source->width, source->height, dstWidth, dstHeight);
+        if (!plan) continue;
+
+        in.source = source;
+        in.sourceU8 = sourceU8;
+        in.plan = plan;
+        in.kernels = getResizeKernels();
+        in.dstWidth = dstWidth;
+        in.dstHeight = dstHeight;
+        in.dest = createImageUninit(dstWidth, dstHeight);
+        in.destU8 = createImageU8(dstWidth, dstHeight, sourceU8->channels);
+        in.jobs = NULL;
+        in.rois = NULL;
+        in.tensor = NULL;
+        memset(&in.u16Src, 0, sizeof(RasterView));
+        in.u16Dst = in.f16Src = in.f16Dst = in.u16Src;
+        in.remapMap = NULL;
+        in.packed = NULL;
+        in.packedU8 = NULL;
+#ifdef HAVE_PTHREADS
+        in.ctx = (ResizeContext*)ctx;
+        in.tiling.tileWidth = cfg->tileWidth;
+        in.tiling.tileHeight = cfg->tileHeight;
+        in.numa = numa;
+        in.numaU8 = numaU8;
+        in.executor = NULL;
+#else
+        (void)ctx;
+#endif
+        if (!in.dest || !in.destU8) {
+            fprintf(stderr, "Error: Failed to allocate %dx%d destination\n", dstWidth, dstHeight);
+            freeImage(in.dest);
+            freeImageU8(in.destU8);
+            freeResizePlan(plan);
             continue;
         }
 
-        /* BENCHMARK SERIAL */
-        startTime = clock();
-        resultSerial = resizeSerial(testImg, targetSize, targetSize);
-        endTime = clock();
-        timeSerial = ((double)(endTime - startTime)) / CLOCKS_PER_SEC * 1000.0;
+        /* Batch: BENCH_BATCH_JOBS thumbnail 8-bit dari sumber yang sama */
+        if ((variantSelected(cfg, "batch") || variantSelected(cfg, "async")) &&
+            (long)dstWidth * dstHeight <= BENCH_BATCH_MAX_PIXELS) {
+            in.jobs = (ResizeJob*)calloc(BENCH_BATCH_JOBS, sizeof(ResizeJob));
+            for (k = 0; in.jobs && k < BENCH_BATCH_JOBS; k++) {
+                in.jobs[k].sourceU8 = sourceU8;
+                in.jobs[k].destU8 = createImageU8(dstWidth, dstHeight, sourceU8->channels);
+                if (!in.jobs[k].destU8) in.jobs[k].sourceU8 = NULL;
+            }
+        }
 
-        printf("  [SERIAL]       Time: %7.0f ms\n", timeSerial);
+        if (variantSelected(cfg, "u16-gray") || variantSelected(cfg, "f16-rgba"))
+            createBenchRasters(&in, source);
+        if (variantSelected(cfg, "tensor") || variantSelected(cfg, "u8-tensor"))
+            in.tensor = (float*)malloc(3 * (size_t)dstWidth * dstHeight * sizeof(float));
 
-        if (resultSerial) freeImage(resultSerial);
+        /* ROI: grid 4x4 sel seperempat sumber, tiap sel diskala rasio
+         * (total pixel tujuan = satu image tujuan, jadi images = 1) */
+        if (variantSelected(cfg, "roi") && source->width >= 4 && source->height >= 4) {
+            int cellW = source->width / 4, cellH = source->height / 4;
+            int roiW = (int)lrint(cellW * cfg->ratios[r]), roiH = (int)lrint(cellH * cfg->ratios[r]);
 
-        /* BENCHMARK OPENMP */
+            in.rois = (ResizeRoi*)calloc(BENCH_BATCH_JOBS, sizeof(ResizeRoi));
+            for (k = 0; in.rois && k < BENCH_BATCH_JOBS; k++) {
+                in.rois[k].x = (k % 4) * cellW;
+                in.rois[k].y = (k / 4) * cellH;
+                in.rois[k].width = cellW;
+                in.rois[k].height = cellH;
+                in.rois[k].destU8 = createImageU8(roiW > 0 ? roiW : 1, roiH > 0 ? roiH : 1,
+                                                  sourceU8->channels);
+            }
+        }
+
+        if (variantSelected(cfg, "remap") || variantSelected(cfg, "remap-packed") ||
+            variantSelected(cfg, "u8-remap-packed")) {
+            in.remapMap = createBenchRemapMap(source->width, source->height, dstWidth, dstHeight);
+            if (in.remapMap) {
+                in.packed = packRemapMap(in.remapMap, source->width, source->height,
+                                         source->stride, REMAP_BORDER_CONSTANT);
+                if (sourceU8->stride % sourceU8->channels == 0)
+                    in.packedU8 = packRemapMap(in.remapMap, sourceU8->width, sourceU8->height,
+                                               sourceU8->stride / sourceU8->channels,
+                                               REMAP_BORDER_CONSTANT);
+            }
+        }
+
+        for (v = 0; v < NUM_BENCH_VARIANTS; v++) {
+            const BenchVariant *variant = &benchVariants[v];
+            int numThreads = variant->threaded ? cfg->numThreads : 1;
+            int numKernels = (variant->run == benchPlan) ? NUM_RESIZE_KERNELS : 1;
+
+            if (!variantSelected(cfg, variant->name)) continue;
+            if (variant->run == benchBatch && !in.jobs) continue;
+#ifdef HAVE_PTHREADS
+            if (variant->run == benchAsync && !in.jobs) continue;
+#endif
+            if (variant->run == benchRoi && !in.rois) continue;
+            if ((variant->run == benchTensor || variant->run == benchU8Tensor) && !in.tensor) continue;
+            if ((variant->run == benchU16Gray || variant->run == benchF16Rgba) &&
+                (!in.u16Src.data || !in.u16Dst.data || !in.f16Src.data || !in.f16Dst.data)) continue;
+            if ((variant->run == benchRemap && !in.remapMap) ||
+                (variant->run == benchRemapPacked && !in.packed) ||
+                (variant->run == benchU8RemapPacked && !in.packedU8)) continue;
+#ifdef HAVE_PTHREADS
+            if ((variant->run == benchPool || variant->run == benchU8Pool ||
+                 variant->run == benchTiled || variant->run == benchU8Tiled) && !in.ctx) continue;
+#endif
+
+            for (k = 0; k < numKernels; k++) {
+                if (variant->run == benchPlan) {
+                    if (!kernelSupported(&kernelTable[k])) continue;
+                    in.kernels = &kernelTable[k];
+                }
+
+                for (t = 0; t < numThreads; t++) {
+                    BenchRecord rec;
+                    int measured;
+
+                    in.threads = variant->threaded ? cfg->threads[t] : 1;
+                    if (variant->run == benchPlan)
+                        snprintf(rec.variant, sizeof(rec.variant), "plan-%s", in.kernels->name);
+                    else
+                        snprintf(rec.variant, sizeof(rec.variant), "%s", variant->name);
+                    rec.srcWidth = source->width;
+                    rec.srcHeight = source->height;
+                    rec.dstWidth = dstWidth;
+                    rec.dstHeight = dstHeight;
+                    rec.threads = in.threads;
+
+#ifdef HAVE_PTHREADS
+                    /* Worker async = thread count record ini, dibuat di luar pengukuran */
+                    if (variant->run == benchAsync) in.executor = createResizeExecutor(in.threads);
+#endif
+                    measured = measureVariant(cfg, variant, &in, &rec);
+#ifdef HAVE_PTHREADS
+                    freeResizeExecutor(in.executor);
+                    in.executor = NULL;
+#endif
+                    if (measured != 0) {
+                        fprintf(stderr, "Error: %s failed for %dx%d -> %dx%d\n", rec.variant,
+                                source->width, source->height, dstWidth, dstHeight);
+                        continue;
+                    }
+                    printBenchRecord(cfg, &rec, *count);
+                    writeBenchProfile(&rec, (*count)++);
+                }
+            }
+            in.kernels = getResizeKernels();
+        }
+
+        if (in.jobs) {
+            for (k = 0; k < BENCH_BATCH_JOBS; k++) freeImageU8(in.jobs[k].destU8);
+            free(in.jobs);
+        }
+        if (in.rois) {
+            for (k = 0; k < BENCH_BATCH_JOBS; k++) freeImageU8(in.rois[k].destU8);
+            free(in.rois);
+        }
+        free(in.tensor);
+        freeBenchRasters(&in);
+        freeRemapMap(in.remapMap);
+        freePackedRemap(in.packed);
+        freePackedRemap(in.packedU8);
+        freeImage(in.dest);
+        freeImageU8(in.destU8);
+        freeResizePlan(plan);
+    }
+#ifdef HAVE_PTHREADS
+    freeNumaSource(numa);
+    freeNumaSource(numaU8);
+#endif
+}
+
+int runBenchHarness(const BenchConfig *cfg) {
+    void *ctx = NULL;
+    int s, status = 0;
+    int count = 0;
+
+    setImageHugePages(cfg->hugePages);
+    if (cfg->poolMB >= 0) setImagePoolLimit((size_t)cfg->poolMB << 20);
+
+#ifdef RESIZE_INSTRUMENT
+    if (cfg->profile) {
+        benchProfileOut = fopen(cfg->profile, "w");
+        if (!benchProfileOut) {
+            fprintf(stderr, "Error: cannot write %s\n", cfg->profile);
+            return 1;
+        }
+        fprintf(benchProfileOut, "[");
+    }
+#endif
+
+#ifdef HAVE_PTHREADS
+    /* Pool dibuat sekali, seukuran thread count terbesar */
+    if (variantSelected(cfg, "pool") || variantSelected(cfg, "u8-pool") ||
+        variantSelected(cfg, "tiled") || variantSelected(cfg, "u8-tiled")) {
+        int maxThreads = 1;
+        for (s = 0; s < cfg->numThreads; s++)
+            if (cfg->threads[s] > maxThreads) maxThreads = cfg->threads[s];
+        ctx = createResizeContext(maxThreads, 1);
+    }
+#endif
+
+    if (cfg->input) {
+#ifdef HAVE_MMAP_IO
+        /* Sumber dari file: path 8-bit membaca mapping langsung (zero-copy) */
+        MappedImage *input = openMappedImage(cfg->input);
+        Image *source = input ? imageFromU8(&input->image) : NULL;
+
+        if (!source) {
+            fprintf(stderr, "Error: cannot read %s (binary PPM/PGM 8-bit)\n", cfg->input);
+            closeMappedImage(input);
+            status = 1;
+            goto done;
+        }
+
+        printBenchHeader(cfg);
+        benchSource(cfg, source, &input->image, ctx, &count);
+        printBenchFooter(cfg);
+
+        freeImage(source);
+        closeMappedImage(input);
+#else
+        fprintf(stderr, "Error: --input needs mmap support\n");
+        status = 1;
+#endif
+        goto done;
+    }
+
+    printBenchHeader(cfg);
+
+    for (s = 0; s < cfg->numSizes; s++) {
+        int size = cfg->sizes[s];
+        Image *source = createTestImage(size);
+        ImageU8 *sourceU8 = createTestImageU8(size, 3);
+
+        if (!source || !sourceU8) {
+            fprintf(stderr, "Error: Failed to create %dx%d test image\n", size, size);
+            freeImage(source);
+            freeImageU8(sourceU8);
+            status = 1;
+            goto done;
+        }
+
+        benchSource(cfg, source, sourceU8, ctx, &count);
+
+        freeImage(source);
+        freeImageU8(sourceU8);
+    }
+
+    printBenchFooter(cfg);
+
+done:
+#ifdef HAVE_PTHREADS
+    freeResizeContext((ResizeContext*)ctx);
+#endif
+#ifdef RESIZE_INSTRUMENT
+    if (benchProfileOut) {
+        fprintf(benchProfileOut, "\n]\n");
+        fclose(benchProfileOut);
+        benchProfileOut = NULL;
+    }
+#endif
+    return status;
+}
+
+/* ============================================================================
+ * SCALING SWEEP & ROOFLINE BANDWIDTH (--scaling)
+ * ============================================================================
+ * Untuk sizing instance: thread 1..max, working set dari muat di L1 sampai
+ * jauh melebihi LLC, dan rasio up/down, untuk kernel float (into) dan
+ * 8-bit (u8-into). Setiap titik dibandingkan dengan peak bandwidth gaya
+ * STREAM (copy & triad, array >= 4x LLC) yang diukur di host yang sama
+ * dengan thread count yang sama. Dilaporkan:
+ *  - GB/s tercapai dan % peak; traffic = baris sumber yang benar-benar
+ *    dibaca plan (decimate 1/n hanya membaca tiap baris ke-n) + tujuan
+ *  - speedup & efisiensi paralel terhadap thread count terkecil
+ *  - bound: "cache" (working set <= LLC), "memory" (>= 70% peak),
+ *    selain itu "compute"
+ * Ringkasan per kernel & rasio: thread count pertama yang memory-bound
+ * di ukuran DRAM, dan thread count terakhir dengan efisiensi >= 50%.
+ */
+
+#define SCALING_MEMORY_BOUND   0.70     /* fraksi peak STREAM */
+#define SCALING_EFFICIENT      0.50
+#define SCALING_POINT_MS       400.0    /* budget waktu terukur per titik */
+#define SCALING_MIN_REPS       3
+#define STREAM_REPS            5
+#define STREAM_MIN_BYTES       ((size_t)64 << 20)
+#define STREAM_MAX_BYTES       ((size_t)512 << 20)
+#define SCALING_NUM_LEVELS     4
+#define SCALING_MAX_SERIES     (2 * SCALING_NUM_LEVELS * BENCH_MAX_LIST)
+
+typedef struct {
+    size_t l1, l2, llc;         /* byte, dari sysconf atau default */
+    size_t maxBytes;            /* working set / array STREAM terbesar */
+} CacheInfo;
+
+typedef struct {
+    int threads;
+    double copyGBs, triadGBs;
+    double peakGBs;             /* max(copy, triad) */
+} StreamResult;
+
+typedef struct {
+    BenchRecord rec;
+    const char *level;          /* L1, L2, LLC, DRAM */
+    double workingSet;          /* byte sumber + tujuan */
+    double ratio;
+    double peakGBs;
+    double peakFraction;
+    double speedup;
+    double efficiency;
+    const char *bound;
+} ScalingPoint;
+
+/* Satu deret (kernel, working set, rasio) di semua thread count */
+typedef struct {
+    char variant[32];           /* salinan: array points ditimpa deret berikutnya */
+    const char *level;
+    double ratio;
+    int memoryFrom;             /* thread count pertama yang memory-bound, 0 = tidak */
+    int efficientTo;            /* thread count terakhir dengan efisiensi >= 50% */
+    int maxThreads;
+    int cacheResident;
+} ScalingSummary;
+
+static size_t cacheSize(int name, size_t fallback) {
+    long value = -1;
+
+#ifdef HAVE_MMAP_IO
+    value = sysconf(name);
+#else
+    (void)name;
+#endif
+    return value > 0 ? (size_t)value : fallback;
+}
+
+static void detectCaches(CacheInfo *info) {
+    size_t phys = 0;
+
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+    info->l1 = cacheSize(_SC_LEVEL1_DCACHE_SIZE, (size_t)32 << 10);
+    info->l2 = cacheSize(_SC_LEVEL2_CACHE_SIZE, (size_t)1 << 20);
+    info->llc = cacheSize(_SC_LEVEL3_CACHE_SIZE, 0);
+    if (info->llc == 0) info->llc = info->l2;
+#else
+    info->l1 = (size_t)32 << 10;
+    info->l2 = (size_t)1 << 20;
+    info->llc = (size_t)32 << 20;
+#endif
+
+#if defined(HAVE_MMAP_IO) && defined(_SC_PHYS_PAGES)
+    if (sysconf(_SC_PHYS_PAGES) > 0 && sysconf(_SC_PAGESIZE) > 0)
+        phys = (size_t)sysconf(_SC_PHYS_PAGES) * (size_t)sysconf(_SC_PAGESIZE);
+#endif
+    /* Working set terbesar (dan total 3 array STREAM) dibatasi 1/4 RAM */
+    info->maxBytes = phys ? phys / 4 : (size_t)1 << 30;
+}
+
+static size_t streamArrayBytes(const CacheInfo *info) {
+    size_t bytes = 4 * info->llc;
+
+    if (bytes < STREAM_MIN_BYTES) bytes = STREAM_MIN_BYTES;
+    if (bytes > STREAM_MAX_BYTES) bytes = STREAM_MAX_BYTES;
+    if (bytes > info->maxBytes / 3) bytes = info->maxBytes / 3;
+    return bytes;
+}
+
+/* STREAM copy (c = a) dan triad (a = b + s*c), waktu terbaik dari
+ * STREAM_REPS; byte dihitung seperti STREAM (2 dan 3 array per iterasi) */
+static int measureStream(int threads, size_t arrayBytes, StreamResult *out) {
+    long n = (long)(arrayBytes / sizeof(double)), i;
+    double *a = (double*)malloc(n * sizeof(double));
+    double *b = (double*)malloc(n * sizeof(double));
+    double *c = (double*)malloc(n * sizeof(double));
+    double bestCopy = 1e30, bestTriad = 1e30, scalar = 3.0;
+    int rep;
+
+    if (!a || !b || !c) {
+        free(a);
+        free(b);
+        free(c);
+        return -1;
+    }
+
+    /* First touch dengan pembagian yang sama dengan loop terukur */
 #ifdef USE_OPENMP
-        {
-            int threadCounts[] = {2, 4, 8};
-            int numThreadTests = 3;
+    #pragma omp parallel for schedule(static) num_threads(threads) if(threads > 1)
+#endif
+    for (i = 0; i < n; i++) {
+        a[i] = 1.0;
+        b[i] = 2.0;
+        c[i] = 0.0;
+    }
 
-            for (i = 0; i < numThreadTests; i++) {
-                int threads = threadCounts[i];
-                Image *resultOmp;
-                double timeOmp, speedup;
+    for (rep = 0; rep < STREAM_REPS; rep++) {
+        double start = nowMs(), elapsed;
 
-                startTime = clock();
-                resultOmp = resizeOpenMP(testImg, targetSize, targetSize, threads);
-                endTime = clock();
-                timeOmp = ((double)(endTime - startTime)) / CLOCKS_PER_SEC * 1000.0;
+#ifdef USE_OPENMP
+        #pragma omp parallel for schedule(static) num_threads(threads) if(threads > 1)
+#endif
+        for (i = 0; i < n; i++) c[i] = a[i];
+        elapsed = nowMs() - start;
+        if (elapsed < bestCopy) bestCopy = elapsed;
 
-                speedup = timeSerial / timeOmp;
-                printf("  [OpenMP-%d]     Time: %7.0f ms  |  Speedup: %.2fx\n",
-                       threads, timeOmp, speedup);
+        start = nowMs();
+#ifdef USE_OPENMP
+        #pragma omp parallel for schedule(static) num_threads(threads) if(threads > 1)
+#endif
+        for (i = 0; i < n; i++) a[i] = b[i] + scalar * c[i];
+        elapsed = nowMs() - start;
+        if (elapsed < bestTriad) bestTriad = elapsed;
+    }
+    (void)threads;
 
-                if (resultOmp) freeImage(resultOmp);
+    out->threads = threads;
+    out->copyGBs = 2.0 * n * sizeof(double) / (bestCopy / 1000.0) / 1.0e9;
+    out->triadGBs = 3.0 * n * sizeof(double) / (bestTriad / 1000.0) / 1.0e9;
+    out->peakGBs = out->copyGBs > out->triadGBs ? out->copyGBs : out->triadGBs;
+
+    free(a);
+    free(b);
+    free(c);
+    return 0;
+}
+
+static const char* cacheLevelName(const CacheInfo *info, double bytes) {
+    if (bytes <= (double)info->l1) return "L1";
+    if (bytes <= (double)info->l2) return "L2";
+    if (bytes <= (double)info->llc) return "LLC";
+    return "DRAM";
+}
+
+/* Sisi sumber persegi agar (src + dst) * byte per pixel ~ workingSet */
+static int scalingSide(double workingSet, double ratio, int pixelBytes) {
+    int side = (int)sqrt(workingSet / (pixelBytes * (1.0 + ratio * ratio)));
+
+    side &= ~7;
+    return side < 8 ? 8 : side;
+}
+
+/* Byte minimum yang harus lewat memori: baris sumber unik yang dibaca
+ * (yIndex0/yIndex1, atau hanya baris n*y untuk decimate) + seluruh tujuan */
+static double scalingTrafficBytes(const ResizePlan *plan, int pixelBytes) {
+    long rows = 0;
+    int y, last = -1;
+
+    for (y = 0; y < plan->dstHeight; y++) {
+        if (plan->yIndex0[y] > last) rows++;
+        last = plan->yIndex0[y];
+        if (plan->ratio == RATIO_DECIMATE) continue;
+        if (plan->yIndex1[y] > last) rows++;
+        last = plan->yIndex1[y];
+    }
+    return ((double)rows * plan->srcWidth + (double)plan->dstWidth * plan->dstHeight) * pixelBytes;
+}
+
+static const BenchVariant* findBenchVariant(const char *name) {
+    int v;
+
+    for (v = 0; v < NUM_BENCH_VARIANTS; v++) {
+        if (strcmp(benchVariants[v].name, name) == 0) return &benchVariants[v];
+    }
+    return NULL;
+}
+
+/* Repetisi agar satu titik ~SCALING_POINT_MS (min SCALING_MIN_REPS,
+ * maks --reps), dari satu run percobaan */
+static int scalingReps(const BenchConfig *cfg, const BenchVariant *v, const BenchInput *in) {
+    double start = nowMs(), elapsed;
+    void *result = v->run(in);
+    int reps;
+
+    if (!result) return -1;
+    v->release(result);
+    elapsed = nowMs() - start;
+
+    reps = elapsed > 0.0 ? (int)(SCALING_POINT_MS / elapsed) : cfg->reps;
+    if (reps > cfg->reps) reps = cfg->reps;
+    if (reps < SCALING_MIN_REPS) reps = SCALING_MIN_REPS;
+    return reps;
+}
+
+static void printScalingPoint(const BenchConfig *cfg, const ScalingPoint *p, int index) {
+    const BenchRecord *r = &p->rec;
+    char src[32], dst[32];
+
+    switch (cfg->format) {
+        case FORMAT_CSV:
+            printf("%s,%s,%.0f,%d,%d,%d,%d,%.4g,%d,%d,%.4f,%.3f,%.3f,%.3f,%.3f,%.3f,%s\n",
+                   r->variant, p->level, p->workingSet, r->srcWidth, r->srcHeight,
+                   r->dstWidth, r->dstHeight, p->ratio, r->threads, r->reps, r->medianMs,
+                   r->gbPerSec, p->peakGBs, p->peakFraction, p->speedup, p->efficiency,
+                   p->bound);
+            break;
+        case FORMAT_JSON:
+            printf("%s\n    {\"variant\": \"%s\", \"level\": \"%s\", \"working_set_bytes\": %.0f, "
+                   "\"src_width\": %d, \"src_height\": %d, \"dst_width\": %d, "
+                   "\"dst_height\": %d, \"ratio\": %.4g, \"threads\": %d, \"reps\": %d, "
+                   "\"median_ms\": %.4f, \"gb_per_s\": %.3f, \"peak_gb_per_s\": %.3f, "
+                   "\"peak_fraction\": %.3f, \"speedup\": %.3f, \"efficiency\": %.3f, "
+                   "\"bound\": \"%s\"}",
+                   index ? "," : "", r->variant, p->level, p->workingSet,
+                   r->srcWidth, r->srcHeight, r->dstWidth, r->dstHeight, p->ratio,
+                   r->threads, r->reps, r->medianMs, r->gbPerSec, p->peakGBs,
+                   p->peakFraction, p->speedup, p->efficiency, p->bound);
+            break;
+        default:
+            snprintf(src, sizeof(src), "%dx%d", r->srcWidth, r->srcHeight);
+            snprintf(dst, sizeof(dst), "%dx%d", r->dstWidth, r->dstHeight);
+            printf("%-8s %-4s %11s %11s %4d %10.3f %8.2f %6.0f%% %7.2f %6.0f%%  %s\n",
+                   r->variant, p->level, src, dst, r->threads, r->medianMs, r->gbPerSec,
+                   100.0 * p->peakFraction, p->speedup, 100.0 * p->efficiency, p->bound);
+            break;
+    }
+    fflush(stdout);
+}
+
+static void summarizeScaling(const ScalingPoint *points, int count, ScalingSummary *s) {
+    int i;
+
+    snprintf(s->variant, sizeof(s->variant), "%s", points[0].rec.variant);
+    s->level = points[0].level;
+    s->ratio = points[0].ratio;
+    s->memoryFrom = 0;
+    s->efficientTo = 0;
+    s->maxThreads = points[count - 1].rec.threads;
+    s->cacheResident = strcmp(points[0].bound, "cache") == 0;
+
+    for (i = 0; i < count; i++) {
+        if (!s->memoryFrom && strcmp(points[i].bound, "memory") == 0)
+            s->memoryFrom = points[i].rec.threads;
+        if (points[i].efficiency >= SCALING_EFFICIENT)
+            s->efficientTo = points[i].rec.threads;
+    }
+}
+
+static void printScalingSummary(const BenchConfig *cfg, const ScalingSummary *s, int index) {
+    switch (cfg->format) {
+        case FORMAT_CSV:
+            break;
+        case FORMAT_JSON:
+            printf("%s\n    {\"variant\": \"%s\", \"level\": \"%s\", \"ratio\": %.4g, "
+                   "\"memory_bound_from_threads\": %d, \"efficient_up_to_threads\": %d}",
+                   index ? "," : "", s->variant, s->level, s->ratio,
+                   s->memoryFrom, s->efficientTo);
+            break;
+        default:
+            printf("  -> %s %s x%.4g: ", s->variant, s->level, s->ratio);
+            if (s->memoryFrom) printf("memory-bound from %d thread(s)", s->memoryFrom);
+            else if (s->cacheResident) printf("cache-resident");
+            else printf("not memory-bound up to %d thread(s)", s->maxThreads);
+            printf(", efficiency >= %.0f%% up to %d thread(s)\n\n",
+                   100.0 * SCALING_EFFICIENT, s->efficientTo);
+            break;
+    }
+}
+
+/* Satu deret thread count untuk (kernel, working set, rasio); return jumlah
+ * titik yang terukur (disimpan di points) */
+static int runScalingSeries(const BenchConfig *cfg, const BenchVariant *variant,
+                            const CacheInfo *info, const StreamResult *stream,
+                            const int *threads, int numThreads, double workingSet,
+                            double ratio, ScalingPoint *points, int *index) {
+    BenchConfig local = *cfg;
+    BenchInput in;
+    Image *source = NULL;
+    ImageU8 *sourceU8 = NULL;
+    ResizePlan *plan;
+    int pixelBytes = variant->u8 ? 3 : (int)sizeof(Pixel);
+    int side = scalingSide(workingSet, ratio, pixelBytes);
+    int dstSide = (int)lrint(side * ratio);
+    int t, count = 0;
+    double baseMs = 0.0;
+    int baseThreads = 0;
+
+    if (dstSide < 1) dstSide = 1;
+    plan = createResizePlan(side, side, dstSide, dstSide);
+
+    memset(&in, 0, sizeof(in));
+    in.plan = plan;
+    in.kernels = getResizeKernels();
+    in.dstWidth = dstSide;
+    in.dstHeight = dstSide;
+    if (variant->u8) {
+        in.sourceU8 = sourceU8 = createTestImageU8(side, 3);
+        in.destU8 = createImageU8(dstSide, dstSide, 3);
+    } else {
+        in.source = source = createTestImage(side);
+        in.dest = createImageUninit(dstSide, dstSide);
+        /* measureVariant menghitung byte 8-bit dari sourceU8->channels */
+    }
+
+    if (!plan || (variant->u8 ? (!sourceU8 || !in.destU8) : (!source || !in.dest))) {
+        fprintf(stderr, "Error: Failed to allocate %dx%d -> %dx%d\n", side, side, dstSide, dstSide);
+        count = -1;
+        goto cleanup;
+    }
+
+    for (t = 0; t < numThreads; t++) {
+        ScalingPoint *p = &points[count];
+        const StreamResult *peak = &stream[t];
+
+        in.threads = threads[t];
+        local.reps = scalingReps(cfg, variant, &in);
+        if (local.reps < 0 || measureVariant(&local, variant, &in, &p->rec) != 0) {
+            fprintf(stderr, "Error: %s failed for %dx%d -> %dx%d\n", variant->name,
+                    side, side, dstSide, dstSide);
+            continue;
+        }
+
+        snprintf(p->rec.variant, sizeof(p->rec.variant), "%s", variant->name);
+        p->rec.srcWidth = p->rec.srcHeight = side;
+        p->rec.dstWidth = p->rec.dstHeight = dstSide;
+        p->rec.threads = threads[t];
+        p->rec.gbPerSec = scalingTrafficBytes(plan, pixelBytes) / (p->rec.medianMs / 1000.0) / 1.0e9;
+        p->workingSet = ((double)side * side + (double)dstSide * dstSide) * pixelBytes;
+        p->level = cacheLevelName(info, p->workingSet);
+        p->ratio = ratio;
+        p->peakGBs = peak->peakGBs;
+        p->peakFraction = peak->peakGBs > 0.0 ? p->rec.gbPerSec / peak->peakGBs : 0.0;
+
+        if (!baseThreads) {
+            baseMs = p->rec.medianMs;
+            baseThreads = threads[t];
+        }
+        p->speedup = baseMs / p->rec.medianMs;
+        p->efficiency = p->speedup * baseThreads / threads[t];
+
+        if (p->workingSet <= (double)info->llc) p->bound = "cache";
+        else if (p->peakFraction >= SCALING_MEMORY_BOUND) p->bound = "memory";
+        else p->bound = "compute";
+
+        printScalingPoint(cfg, p, (*index)++);
+        count++;
+    }
+
+cleanup:
+    freeImage(source);
+    freeImage(in.dest);
+    freeImageU8(sourceU8);
+    freeImageU8(in.destU8);
+    freeResizePlan(plan);
+    return count;
+}
+
+/* Thread count default: 1, 2, 4, ... sampai max (max selalu ikut) */
+static int defaultScalingThreads(int *threads) {
+    int maxThreads = 1, n = 0, t;
+
+#ifdef USE_OPENMP
+    maxThreads = omp_get_max_threads();
+#endif
+    for (t = 1; t < maxThreads && n < BENCH_MAX_LIST - 1; t *= 2) threads[n++] = t;
+    threads[n++] = maxThreads;
+    return n;
+}
+
+int runScalingSweep(const BenchConfig *cfg) {
+    static const char *kernels[] = { "into", "u8-into" };
+    CacheInfo info;
+    StreamResult stream[BENCH_MAX_LIST];
+    ScalingPoint points[BENCH_MAX_LIST];
+    ScalingSummary summaries[SCALING_MAX_SERIES];
+    double levels[SCALING_NUM_LEVELS], candidates[SCALING_NUM_LEVELS];
+    int threads[BENCH_MAX_LIST];
+    int numThreads, numLevels = 0;
+    int k, l, r, t, index = 0, numSummaries = 0;
+    size_t arrayBytes;
+
+    detectCaches(&info);
+    arrayBytes = streamArrayBytes(&info);
+
+    if (cfg->threadsGiven) {
+        numThreads = cfg->numThreads;
+        memcpy(threads, cfg->threads, numThreads * sizeof(int));
+    } else {
+        numThreads = defaultScalingThreads(threads);
+    }
+
+    /* Working set: setengah L1, L2 dan LLC (resident) lalu 4x LLC (DRAM),
+     * dibatasi maxBytes; level yang tidak lebih besar dari sebelumnya dibuang */
+    candidates[0] = info.l1 / 2.0;
+    candidates[1] = info.l2 / 2.0;
+    candidates[2] = info.llc / 2.0;
+    candidates[3] = 4.0 * info.llc;
+    for (l = 0; l < SCALING_NUM_LEVELS; l++) {
+        double ws = candidates[l] < (double)info.maxBytes ? candidates[l] : (double)info.maxBytes;
+
+        if (numLevels == 0 || ws > levels[numLevels - 1]) levels[numLevels++] = ws;
+    }
+
+    for (t = 0; t < numThreads; t++) {
+        if (measureStream(threads[t], arrayBytes, &stream[t]) != 0) {
+            fprintf(stderr, "Error: Failed to allocate STREAM arrays (%zu MB)\n", arrayBytes >> 20);
+            return 1;
+        }
+    }
+
+    switch (cfg->format) {
+        case FORMAT_CSV:
+            printf("variant,level,working_set_bytes,src_width,src_height,dst_width,dst_height,"
+                   "ratio,threads,reps,median_ms,gb_per_s,peak_gb_per_s,peak_fraction,"
+                   "speedup,efficiency,bound\n");
+            break;
+        case FORMAT_JSON:
+            printf("{\n  \"benchmark\": \"bilinear-scaling\",\n");
+            printf("  \"kernel\": \"%s\",\n", getResizeKernels()->name);
+            printf("  \"caches\": {\"l1\": %zu, \"l2\": %zu, \"llc\": %zu},\n",
+                   info.l1, info.l2, info.llc);
+            printf("  \"stream_array_bytes\": %zu,\n  \"stream\": [", arrayBytes);
+            for (t = 0; t < numThreads; t++) {
+                printf("%s\n    {\"threads\": %d, \"copy_gb_per_s\": %.3f, "
+                       "\"triad_gb_per_s\": %.3f}",
+                       t ? "," : "", stream[t].threads, stream[t].copyGBs, stream[t].triadGBs);
+            }
+            printf("\n  ],\n  \"points\": [");
+            break;
+        default:
+            printf("Caches: L1 %zu KB, L2 %zu KB, LLC %zu KB   Kernel: %s\n",
+                   info.l1 >> 10, info.l2 >> 10, info.llc >> 10, getResizeKernels()->name);
+            printf("STREAM (%zu MB arrays):\n", arrayBytes >> 20);
+            for (t = 0; t < numThreads; t++) {
+                printf("  %3d thread(s)  copy %8.2f GB/s  triad %8.2f GB/s\n",
+                       stream[t].threads, stream[t].copyGBs, stream[t].triadGBs);
+            }
+            printf("\n%-8s %-4s %11s %11s %4s %10s %8s %7s %7s %7s  %s\n",
+                   "kernel", "set", "src", "dst", "thr", "median ms", "GB/s", "%peak",
+                   "speedup", "eff", "bound");
+            printf("-----------------------------------------------------------------------------------------------\n");
+            break;
+    }
+
+    /* Text: ringkasan langsung di bawah deretnya; JSON: array terpisah */
+    for (k = 0; k < 2; k++) {
+        const BenchVariant *variant = findBenchVariant(kernels[k]);
+
+        if (!variant || !variantSelected(cfg, kernels[k])) continue;
+        for (l = 0; l < numLevels; l++) {
+            for (r = 0; r < cfg->numRatios; r++) {
+                ScalingSummary *s = &summaries[numSummaries];
+                int n = runScalingSeries(cfg, variant, &info, stream, threads, numThreads,
+                                         levels[l], cfg->ratios[r], points, &index);
+
+                if (n <= 0) continue;
+                summarizeScaling(points, n, s);
+                if (cfg->format == FORMAT_TEXT) printScalingSummary(cfg, s, numSummaries);
+                numSummaries++;
             }
         }
+    }
+
+    if (cfg->format == FORMAT_JSON) {
+        printf("\n  ],\n  \"summary\": [");
+        for (k = 0; k < numSummaries; k++) printScalingSummary(cfg, &summaries[k], k);
+        printf("\n  ]\n}\n");
+    }
+    return 0;
+}
+
+/* Parse "a,b,c" ke array int/double; return jumlah elemen, atau -1 jika
+ * ada elemen tidak valid atau lebih dari maxCount */
+static int parseIntList(const char *text, int *out, int maxCount) {
+    int n = 0;
+    char *end;
+
+    while (*text && n < maxCount) {
+        long value = strtol(text, &end, 10);
+        if (end == text || value <= 0) return -1;
+        out[n++] = (int)value;
+        text = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',') return -1;
+    }
+    return *text ? -1 : n;
+}
+
+static int parseDoubleList(const char *text, double *out, int maxCount) {
+    int n = 0;
+    char *end;
+
+    while (*text && n < maxCount) {
+        double value = strtod(text, &end);
+        if (end == text || value <= 0.0) return -1;
+        out[n++] = value;
+        text = (*end == ',') ? end + 1 : end;
+        if (*end && *end != ',') return -1;
+    }
+    return *text ? -1 : n;
+}
+
+static void printUsage(const char *prog) {
+    printf("Usage: %s [--bench [options]]\n", prog);
+    printf("       %s --scaling [options]\n", prog);
+    printf("       %s --selftest\n", prog);
+    printf("       %s --resize IN OUT WxH [--threads N] [--raw-size WxHxC]\n\n", prog);
+    printf("Without arguments: print concept and run the short benchmark.\n\n");
+    printf("--resize reads binary PPM/PGM (8-bit) or raw files through mmap and\n");
+    printf("writes PPM/PGM/raw chosen by the output extension.\n\n");
+    printf("--scaling sweeps threads (default 1,2,4..max), working sets from L1 to\n");
+    printf("4x LLC and --ratios for the into and u8-into kernels. It reports GB/s\n");
+    printf("against a STREAM peak measured per thread count, parallel efficiency\n");
+    printf("and whether each point is cache-, memory- or compute-bound. Accepts\n");
+    printf("--threads, --ratios, --variants, --warmup, --reps (max per point) and\n");
+    printf("--format.\n\n");
+    printf("--selftest checks the ratio fast paths, dirty-rectangle, context, tiled\n");
+    printf("and async paths against the scalar general path (float and 8-bit,\n");
+    printf("1/3/4 channels), plus a PGM round trip with maxval < 255, and exits\n");
+    printf("with status 1 on any difference.\n\n");
+    printf("Benchmark harness options:\n");
+    printf("  --sizes LIST      Square source sizes (default 512,1024,2048)\n");
+    printf("  --ratios LIST     Scale ratios dst/src (default 4,2,1,0.5)\n");
+    printf("  --threads LIST    Thread counts for OpenMP variants (default 1,max)\n");
+    printf("  --warmup N        Warm-up runs per configuration (default 2)\n");
+    printf("  --reps N          Timed repetitions per configuration (default 10)\n");
+    printf("  --variants LIST   serial,plan,u8,into,cached,dirty,u8-into,stream,batch,\n");
+    printf("                    roi,tensor,u8-tensor,u16-gray,f16-rgba,area,mipmap,\n");
+    printf("                    pyramid,remap,remap-packed,u8-remap-packed,pool,u8-pool,\n");
+    printf("                    tiled,u8-tiled,pipeline,async,openmp,openmp-plan,u8-openmp\n");
+    printf("                    (default all)\n");
+    printf("  --tile WxH        Tile size for tiled variants (default 256x64)\n");
+    printf("  --numa MODE       Source placement for tiled variants:\n");
+    printf("                    shared, interleave or replicate (default shared)\n");
+    printf("  --hugepages MODE  Backing for image buffers >= 2 MB: off, thp or\n");
+    printf("                    explicit (MAP_HUGETLB, falls back to thp)\n");
+    printf("  --pool-mb N       Idle image buffers kept for reuse (default 256, 0 = off)\n");
+    printf("  --format FMT      text, csv or json (default text)\n");
+    printf("  --input FILE      Use a PPM/PGM file as source instead of --sizes\n");
+    printf("  --profile FILE    Write per-thread busy/idle, phase times and hardware\n");
+    printf("                    counters per result as JSON (build with\n");
+    printf("                    -DRESIZE_INSTRUMENT)\n");
+}
+
+/* Parse argumen CLI ke BenchConfig; return 0 sukses, -1 error, 1 untuk --help */
+int parseBenchArgs(int argc, char **argv, BenchConfig *cfg) {
+    int i;
+
+    cfg->sizes[0] = 512; cfg->sizes[1] = 1024; cfg->sizes[2] = 2048;
+    cfg->numSizes = 3;
+    cfg->ratios[0] = 4.0; cfg->ratios[1] = 2.0; cfg->ratios[2] = 1.0; cfg->ratios[3] = 0.5;
+    cfg->numRatios = 4;
+    cfg->threads[0] = 1;
+    cfg->numThreads = 1;
+    cfg->threadsGiven = 0;
+#ifdef USE_OPENMP
+    if (omp_get_max_threads() > 1) {
+        cfg->threads[1] = omp_get_max_threads();
+        cfg->numThreads = 2;
+    }
+#endif
+    cfg->warmup = 2;
+    cfg->reps = 10;
+    cfg->format = FORMAT_TEXT;
+    cfg->variants = NULL;
+    cfg->input = NULL;
+    cfg->tileWidth = 0;
+    cfg->tileHeight = 0;
+    cfg->numaPolicy = 0;
+    cfg->profile = NULL;
+    cfg->hugePages = HUGEPAGE_TRANSPARENT;
+    cfg->poolMB = -1;
+
+    for (i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--bench") == 0 || strcmp(arg, "--scaling") == 0) continue;
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) return 1;
+
+        if (strcmp(arg, "--sizes") != 0 && strcmp(arg, "--ratios") != 0 &&
+            strcmp(arg, "--threads") != 0 && strcmp(arg, "--warmup") != 0 &&
+            strcmp(arg, "--reps") != 0 && strcmp(arg, "--variants") != 0 &&
+            strcmp(arg, "--format") != 0 && strcmp(arg, "--input") != 0 &&
+            strcmp(arg, "--tile") != 0 && strcmp(arg, "--numa") != 0 &&
+            strcmp(arg, "--profile") != 0 && strcmp(arg, "--hugepages") != 0 &&
+            strcmp(arg, "--pool-mb") != 0) {
+            fprintf(stderr, "Error: unknown option %s\n", arg);
+            return -1;
+        }
+        if (!value) {
+            fprintf(stderr, "Error: missing value for %s\n", arg);
+            return -1;
+        }
+        i++;
+
+        if (strcmp(arg, "--sizes") == 0) {
+            cfg->numSizes = parseIntList(value, cfg->sizes, BENCH_MAX_LIST);
+            if (cfg->numSizes <= 0) goto badValue;
+        } else if (strcmp(arg, "--ratios") == 0) {
+            cfg->numRatios = parseDoubleList(value, cfg->ratios, BENCH_MAX_LIST);
+            if (cfg->numRatios <= 0) goto badValue;
+        } else if (strcmp(arg, "--threads") == 0) {
+            cfg->numThreads = parseIntList(value, cfg->threads, BENCH_MAX_LIST);
+            if (cfg->numThreads <= 0) goto badValue;
+            cfg->threadsGiven = 1;
+        } else if (strcmp(arg, "--warmup") == 0) {
+            cfg->warmup = atoi(value);
+            if (cfg->warmup < 0) goto badValue;
+        } else if (strcmp(arg, "--reps") == 0) {
+            cfg->reps = atoi(value);
+            if (cfg->reps <= 0) goto badValue;
+        } else if (strcmp(arg, "--variants") == 0) {
+            cfg->variants = value;
+        } else if (strcmp(arg, "--input") == 0) {
+            cfg->input = value;
+        } else if (strcmp(arg, "--profile") == 0) {
+#ifdef RESIZE_INSTRUMENT
+            cfg->profile = value;
 #else
-        printf("  [OpenMP]       Not compiled (compile with -fopenmp -DUSE_OPENMP)\n");
+            fprintf(stderr, "Error: --profile needs a build with -DRESIZE_INSTRUMENT\n");
+            return -1;
 #endif
+        } else if (strcmp(arg, "--tile") == 0) {
+            if (sscanf(value, "%dx%d", &cfg->tileWidth, &cfg->tileHeight) != 2 ||
+                cfg->tileWidth <= 0 || cfg->tileHeight <= 0) goto badValue;
+        } else if (strcmp(arg, "--numa") == 0) {
+            if (strcmp(value, "shared") == 0) cfg->numaPolicy = 0;
+            else if (strcmp(value, "interleave") == 0) cfg->numaPolicy = 1;
+            else if (strcmp(value, "replicate") == 0) cfg->numaPolicy = 2;
+            else goto badValue;
+        } else if (strcmp(arg, "--hugepages") == 0) {
+            if (strcmp(value, "off") == 0) cfg->hugePages = HUGEPAGE_OFF;
+            else if (strcmp(value, "thp") == 0) cfg->hugePages = HUGEPAGE_TRANSPARENT;
+            else if (strcmp(value, "explicit") == 0) cfg->hugePages = HUGEPAGE_EXPLICIT;
+            else goto badValue;
+        } else if (strcmp(arg, "--pool-mb") == 0) {
+            cfg->poolMB = atoi(value);
+            if (cfg->poolMB < 0) goto badValue;
+        } else if (strcmp(arg, "--format") == 0) {
+            if (strcmp(value, "text") == 0) cfg->format = FORMAT_TEXT;
+            else if (strcmp(value, "csv") == 0) cfg->format = FORMAT_CSV;
+            else if (strcmp(value, "json") == 0) cfg->format = FORMAT_JSON;
+            else goto badValue;
+        }
+        continue;
 
-        printf("\n");
-        freeImage(testImg);
+    badValue:
+        fprintf(stderr, "Error: invalid value '%s' for %s\n", value, arg);
+        return -1;
     }
 
-    printf("========================================================================\n");
+    return 0;
 }
 
 /* ============================================================================
@@ -332,7 +7563,75 @@ void printConcept() {
  * MAIN
  * ============================================================================ */
 
-int main() {
+/* Parse --resize IN OUT WxH [--threads N] [--raw-size WxHxC] */
+static int runResizeCommand(int argc, char **argv) {
+    int dstWidth, dstHeight;
+    int rawWidth = 0, rawHeight = 0, rawChannels = 0;
+    int numThreads = 1;
+    int i;
+
+    if (argc < 5 || sscanf(argv[4], "%dx%d", &dstWidth, &dstHeight) != 2 ||
+        dstWidth <= 0 || dstHeight <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+#ifdef USE_OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+
+    for (i = 5; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--threads") == 0) {
+            if (parseIntList(argv[i + 1], &numThreads, 1) != 1) {
+                fprintf(stderr, "Error: invalid value '%s' for --threads\n", argv[i + 1]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--raw-size") == 0) {
+            if (sscanf(argv[i + 1], "%dx%dx%d", &rawWidth, &rawHeight, &rawChannels) != 3 ||
+                rawWidth <= 0 || rawHeight <= 0 || !u8ChannelsSupported(rawChannels)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            break;
+        }
+    }
+    if (i < argc) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+#ifdef HAVE_MMAP_IO
+    return runResizeFile(argv[2], argv[3], dstWidth, dstHeight,
+                         rawWidth, rawHeight, rawChannels, numThreads);
+#else
+    (void)rawWidth; (void)rawHeight; (void)rawChannels; (void)numThreads;
+    fprintf(stderr, "Error: --resize needs mmap support\n");
+    return 1;
+#endif
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "--resize") == 0) {
+        return runResizeCommand(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "--selftest") == 0) {
+        return runSelfTest();
+    }
+
+    if (argc > 1) {
+        BenchConfig cfg;
+        int status = parseBenchArgs(argc, argv, &cfg);
+
+        if (status != 0 ||
+            (strcmp(argv[1], "--bench") != 0 && strcmp(argv[1], "--scaling") != 0)) {
+            printUsage(argv[0]);
+            return status < 0 ? 1 : 0;
+        }
+        if (strcmp(argv[1], "--scaling") == 0) return runScalingSweep(&cfg);
+        return runBenchHarness(&cfg);
+    }
+
     printf("\n");
     printf("╔═══════════════════════════════════════════════════════════════╗\n");
     printf("║     BILINEAR INTERPOLATION: SERIAL vs PARALLEL (C + OpenMP)  ║\n");
@@ -343,6 +7642,7 @@ int main() {
     printf("Compilation Mode:\n");
     printf("  Language: Pure C (C99)\n");
     printf("  Serial:   ENABLED\n");
+    printf("  Kernel:   %s (auto-detected)\n", getResizeKernels()->name);
 
 #ifdef USE_OPENMP
     printf("  OpenMP:   ENABLED\n");